@@ -84,6 +84,7 @@ int main() {
     if (auto const json = parse(input); json.has_value()) {
         std::println("{}", (*json)->pretty_print().c_str());
     } else {
-        std::println(std::cerr, "Error: {}", std::visit([](auto const& error) { return error.message; }, json.error()));
+        auto const message = std::visit([](auto const& error) { return error.message(); }, json.error());
+        std::println(std::cerr, "Error: {}", message);
     }
 }
@@ -0,0 +1,50 @@
+#include <simple_json_parser/detail/array_stream.hpp>
+#include <simple_json_parser/detail/parser.hpp>
+#include <utility>
+
+namespace c2k::json {
+    ArrayStream::ArrayStream(Utf8StringView const input)
+        : m_parser{ std::make_unique<detail::Parser>(input, m_state) } {}
+
+    ArrayStream::~ArrayStream() = default;
+
+    [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> ArrayStream::next() {
+        advance();
+        return std::exchange(m_current, tl::nullopt);
+    }
+
+    [[nodiscard]] ArrayStream::Iterator ArrayStream::begin() {
+        if (not m_has_started) {
+            advance();
+        }
+        return Iterator{ *this };
+    }
+
+    void ArrayStream::advance() {
+        // release the previous element before parsing the next one to keep the peak memory usage low
+        m_current = tl::nullopt;
+        if (m_is_done) {
+            return;
+        }
+        auto const is_first = not m_has_started;
+        m_has_started = true;
+        if (is_first) {
+            if (auto const result = m_parser->begin_array(); not result.has_value()) {
+                m_is_done = true;
+                m_current = std::unexpected{ result.error() };
+                return;
+            }
+        }
+        auto result = m_parser->parse_next_element(is_first);
+        if (not result.has_value()) {
+            m_is_done = true;
+            m_current = std::unexpected{ result.error() };
+            return;
+        }
+        if (not result->has_value()) {
+            m_is_done = true;
+            return;
+        }
+        m_current = std::move(result).value().value();
+    }
+}  // namespace c2k::json
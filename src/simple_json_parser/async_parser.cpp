@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <simple_json_parser/detail/async_parser.hpp>
+#include <simple_json_parser/detail/parser.hpp>
+#include <simple_json_parser/detail/utf8.hpp>
+#include <variant>
+
+namespace c2k::json::detail {
+    namespace {
+        [[nodiscard]] bool is_whitespace(char const c) {
+            return c == 0x20 or c == 0x0A or c == 0x0D or c == 0x09;
+        }
+    }  // namespace
+
+    [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> IncrementalArrayParser::next() {
+        switch (m_phase) {
+            case Phase::BeforeArray: {
+                auto const input = unconsumed();
+                auto const start = std::ranges::find_if_not(input, is_whitespace);
+                if (start == input.end()) {
+                    if (m_is_end_of_input) {
+                        return fail(ParseErrorCode::UnexpectedEndOfInput, input.size());
+                    }
+                    consume(input.size());
+                    return tl::nullopt;
+                }
+                if (*start != '[') {
+                    m_phase = Phase::WholeDocument;
+                    return next();
+                }
+                consume(static_cast<usize>(start - input.begin()) + 1);  // also consume '['
+                m_phase = Phase::InArray;
+                return next_element();
+            }
+            case Phase::InArray:
+                return next_element();
+            case Phase::WholeDocument: {
+                if (not m_is_end_of_input) {
+                    return tl::nullopt;
+                }
+                m_phase = Phase::Done;
+                return parse_element(unconsumed(), false);
+            }
+            case Phase::Done:
+                break;
+        }
+        return tl::nullopt;
+    }
+
+    [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> IncrementalArrayParser::next_element() {
+        // only structural characters are of interest, and those can't be part of multibyte UTF-8 sequences
+        auto const input = unconsumed();
+        for (; m_scan_position < input.size(); ++m_scan_position) {
+            auto const c = input.at(m_scan_position);
+            if (m_is_in_string) {
+                if (m_is_escaped) {
+                    m_is_escaped = false;
+                } else if (c == '\\') {
+                    m_is_escaped = true;
+                } else if (c == '"') {
+                    m_is_in_string = false;
+                }
+                continue;
+            }
+            switch (c) {
+                case '"':
+                    m_is_in_string = true;
+                    continue;
+                case '[':
+                case '{':
+                    ++m_depth;
+                    continue;
+                case '}':
+                    if (m_depth == 0) {
+                        return fail(ParseErrorCode::UnexpectedCharacter, m_scan_position);
+                    }
+                    --m_depth;
+                    continue;
+                case ']':
+                    if (m_depth > 0) {
+                        --m_depth;
+                        continue;
+                    }
+                    break;
+                case ',':
+                    if (m_depth > 0) {
+                        continue;
+                    }
+                    break;
+                default:
+                    continue;
+            }
+
+            // `c` terminates the current element
+            auto const text = input.substr(0, m_scan_position);
+            auto const is_blank = std::ranges::all_of(text, is_whitespace);
+            if (c == ']' and is_blank and m_num_elements == 0) {
+                m_phase = Phase::Done;  // empty array
+                return tl::nullopt;
+            }
+            if (is_blank) {
+                return fail(ParseErrorCode::UnexpectedCharacter, m_scan_position);
+            }
+            auto result = parse_element(text, true);
+            if (not result.has_value()) {
+                m_phase = Phase::Done;
+                return result;
+            }
+            ++m_num_elements;
+            consume(m_scan_position + 1);
+            m_scan_position = 0;
+            if (c == ']') {
+                m_phase = Phase::Done;
+            }
+            return result;
+        }
+        if (m_is_end_of_input) {
+            return fail(ParseErrorCode::UnexpectedEndOfInput, input.size());
+        }
+        return tl::nullopt;
+    }
+
+    [[nodiscard]] std::expected<ValuePointer, Error> IncrementalArrayParser::parse_element(
+        std::string_view const text,
+        bool const is_array_element
+    ) {
+        if (not is_valid_utf8(text)) {
+            return fail(ParseErrorCode::InvalidUtf8, 0);
+        }
+        auto const input = Utf8String{ std::string{ text } };
+        auto parser = Parser{ input, m_state };
+        auto result = [&]() -> std::expected<ValuePointer, Error> {
+            if (not is_array_element) {
+                return parser.parse();
+            }
+            // the text can't contain a top-level comma, so there's at most one element
+            auto elements = parser.parse_elements();
+            if (not elements.has_value()) {
+                return std::unexpected{ elements.error() };
+            }
+            return std::move(elements->front());
+        }();
+        if (not result.has_value()) {
+            // the parser only knows the offset within `text`
+            if (auto const parse_error = std::get_if<ParseError>(&result.error())) {
+                parse_error->offset += m_num_consumed_bytes;
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::expected<ValuePointer, Error> IncrementalArrayParser::fail(
+        ParseErrorCode const code,
+        usize const offset
+    ) {
+        m_phase = Phase::Done;
+        return std::unexpected{ ParseError{ code, m_num_consumed_bytes + offset } };
+    }
+}  // namespace c2k::json::detail
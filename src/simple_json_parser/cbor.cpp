@@ -0,0 +1,409 @@
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/boolean.hpp>
+#include <simple_json_parser/detail/cbor.hpp>
+#include <simple_json_parser/detail/null.hpp>
+#include <simple_json_parser/detail/number.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/string.hpp>
+#include <simple_json_parser/detail/utf8.hpp>
+#include <unordered_set>
+
+namespace c2k::json {
+    namespace {
+        enum class MajorType : u8 {
+            UnsignedInteger = 0,
+            NegativeInteger = 1,
+            ByteString = 2,
+            TextString = 3,
+            Array = 4,
+            Map = 5,
+            Tag = 6,
+            Simple = 7,
+        };
+
+        constexpr auto indefinite_length = u8{ 31 };
+        constexpr auto break_code = std::byte{ 0xFF };
+        constexpr auto false_code = std::byte{ 0xF4 };
+        constexpr auto true_code = std::byte{ 0xF5 };
+        constexpr auto null_code = std::byte{ 0xF6 };
+        constexpr auto float32_code = std::byte{ 0xFA };
+        constexpr auto float64_code = std::byte{ 0xFB };
+        // protects the decoder (which is recursive) against deeply nested input
+        constexpr auto max_decoding_depth = usize{ 1024 };
+
+        class Encoder final {
+            std::vector<std::byte> m_output;
+
+        public:
+            [[nodiscard]] std::vector<std::byte> encode(Value const& value) && {
+                write_value(value);
+                return std::move(m_output);
+            }
+
+        private:
+            void write_value(Value const& value) {
+                if (auto const object = value.as_object()) {
+                    write_head(MajorType::Map, object->values.size());
+                    for (auto const& [key, member_value] : object->values) {
+                        write_string(key.value);
+                        write_value(*member_value);
+                    }
+                } else if (auto const array = value.as_array()) {
+                    write_head(MajorType::Array, array->elements.size());
+                    for (auto const& element : array->elements) {
+                        write_value(*element);
+                    }
+                } else if (auto const string = value.as_string()) {
+                    write_string(string->value);
+                } else if (auto const number = value.as_number()) {
+                    write_number(number->value);
+                } else if (auto const boolean = value.as_boolean()) {
+                    m_output.push_back(boolean->value ? true_code : false_code);
+                } else {
+                    m_output.push_back(null_code);
+                }
+            }
+
+            void write_head(MajorType const type, u64 const argument) {
+                auto const major = static_cast<u8>(std::to_underlying(type) << 5);
+                if (argument < 24) {
+                    m_output.push_back(std::byte{ static_cast<u8>(major | argument) });
+                } else if (argument <= 0xFF) {
+                    m_output.push_back(std::byte{ static_cast<u8>(major | 24) });
+                    write_big_endian(argument, 1);
+                } else if (argument <= 0xFFFF) {
+                    m_output.push_back(std::byte{ static_cast<u8>(major | 25) });
+                    write_big_endian(argument, 2);
+                } else if (argument <= 0xFFFF'FFFF) {
+                    m_output.push_back(std::byte{ static_cast<u8>(major | 26) });
+                    write_big_endian(argument, 4);
+                } else {
+                    m_output.push_back(std::byte{ static_cast<u8>(major | 27) });
+                    write_big_endian(argument, 8);
+                }
+            }
+
+            void write_big_endian(u64 const value, usize const num_bytes) {
+                for (auto i = num_bytes; i > 0; --i) {
+                    m_output.push_back(std::byte{ static_cast<u8>(value >> ((i - 1) * 8)) });
+                }
+            }
+
+            void write_string(Utf8String const& string) {
+                write_head(MajorType::TextString, string.view().num_bytes());
+                for (auto const c : string) {
+                    for (auto const byte : c.as_string_view()) {
+                        m_output.push_back(static_cast<std::byte>(byte));
+                    }
+                }
+            }
+
+            void write_number(double const value) {
+                // 2^64, all integral values below this limit fit into a CBOR integer
+                static constexpr auto integer_limit = 18446744073709551616.0;
+                auto const is_integral = std::isfinite(value) and std::trunc(value) == value
+                                         and not(value == 0.0 and std::signbit(value));
+                if (is_integral and value >= 0.0 and value < integer_limit) {
+                    write_head(MajorType::UnsignedInteger, static_cast<u64>(value));
+                    return;
+                }
+                // -2^64 itself would need 2^64 - 1 + 1 as argument, which doesn't fit into 64 bits
+                if (is_integral and value < 0.0 and value > -integer_limit) {
+                    // a negative integer n is encoded as -1 - n
+                    write_head(MajorType::NegativeInteger, static_cast<u64>(-(value + 1.0)));
+                    return;
+                }
+                // narrowing a finite value that is out of the range of `float` is undefined behavior
+                static constexpr auto float_max = static_cast<double>(std::numeric_limits<float>::max());
+                auto const fits_into_float = not std::isfinite(value) or std::abs(value) <= float_max;
+                if (fits_into_float) {
+                    if (auto const single = static_cast<float>(value); static_cast<double>(single) == value) {
+                        m_output.push_back(float32_code);
+                        write_big_endian(std::bit_cast<u32>(single), 4);
+                        return;
+                    }
+                }
+                m_output.push_back(float64_code);
+                write_big_endian(std::bit_cast<u64>(value), 8);
+            }
+        };
+
+        class Decoder final {
+            std::span<std::byte const> m_data;
+            usize m_position = 0;
+            usize m_depth = 0;
+
+        public:
+            explicit Decoder(std::span<std::byte const> const data)
+                : m_data{ data } {}
+
+            [[nodiscard]] std::expected<ValuePointer, Error> decode() {
+                auto result = value();
+                if (result.has_value() and m_position != m_data.size()) {
+                    return decode_error("unexpected data after the end of the encoded value");
+                }
+                return result;
+            }
+
+        private:
+            struct Head final {
+                MajorType type;
+                u8 additional_information;
+                u64 argument;
+            };
+
+            [[nodiscard]] std::unexpected<Error> decode_error(std::string message) const {
+                return std::unexpected<Error>{
+                    DecodeError{ std::format("{} (at byte offset {})", message, m_position) },
+                };
+            }
+
+            [[nodiscard]] std::expected<u64, Error> read_big_endian(usize const num_bytes) {
+                if (m_data.size() - m_position < num_bytes) {
+                    return decode_error("unexpected end of input");
+                }
+                auto result = u64{ 0 };
+                for (auto i = usize{ 0 }; i < num_bytes; ++i) {
+                    result = (result << 8) | std::to_integer<u64>(m_data[m_position + i]);
+                }
+                m_position += num_bytes;
+                return result;
+            }
+
+            [[nodiscard]] std::expected<Head, Error> head() {
+                if (m_position == m_data.size()) {
+                    return decode_error("unexpected end of input");
+                }
+                auto const initial_byte = std::to_integer<u8>(m_data[m_position]);
+                ++m_position;
+                auto const type = static_cast<MajorType>(initial_byte >> 5);
+                auto const additional_information = static_cast<u8>(initial_byte & 0x1F);
+                if (additional_information < 24 or additional_information == indefinite_length) {
+                    return Head{ type, additional_information, additional_information };
+                }
+                if (additional_information > 27) {
+                    return decode_error("invalid additional information");
+                }
+                auto const argument = read_big_endian(usize{ 1 } << (additional_information - 24));
+                if (not argument.has_value()) {
+                    return std::unexpected{ argument.error() };
+                }
+                return Head{ type, additional_information, argument.value() };
+            }
+
+            [[nodiscard]] bool is_at_break() const {
+                return m_position < m_data.size() and m_data[m_position] == break_code;
+            }
+
+            [[nodiscard]] std::expected<ValuePointer, Error> value() {
+                auto const head_result = head();
+                if (not head_result.has_value()) {
+                    return std::unexpected{ head_result.error() };
+                }
+                auto const head = head_result.value();
+                auto const is_indefinite = head.additional_information == indefinite_length;
+                switch (head.type) {
+                    case MajorType::UnsignedInteger:
+                    case MajorType::NegativeInteger:
+                        if (is_indefinite) {
+                            return decode_error("invalid additional information");
+                        }
+                        if (head.type == MajorType::NegativeInteger) {
+                            return std::make_unique<Number>(-1.0 - static_cast<double>(head.argument));
+                        }
+                        return std::make_unique<Number>(static_cast<double>(head.argument));
+                    case MajorType::ByteString:
+                        return decode_error("byte strings are not supported");
+                    case MajorType::TextString: {
+                        auto text = text_string(head);
+                        if (not text.has_value()) {
+                            return std::unexpected{ text.error() };
+                        }
+                        return std::make_unique<String>(std::move(text).value());
+                    }
+                    case MajorType::Array:
+                    case MajorType::Map:
+                    case MajorType::Tag: {
+                        if (head.type == MajorType::Tag and is_indefinite) {
+                            return decode_error("invalid additional information");
+                        }
+                        if (m_depth == max_decoding_depth) {
+                            return decode_error("maximum nesting depth exceeded");
+                        }
+                        ++m_depth;
+                        auto result = head.type == MajorType::Array ? array(head)
+                                      : head.type == MajorType::Map ? map(head)
+                                                                    : value();  // tags are skipped
+                        --m_depth;
+                        return result;
+                    }
+                    case MajorType::Simple:
+                        return simple_value(head);
+                }
+                return decode_error("invalid major type");
+            }
+
+            [[nodiscard]] std::expected<Utf8String, Error> text_string(Head const& head) {
+                auto bytes = std::string{};
+                auto const append_chunk = [&](u64 const length) -> std::expected<std::monostate, Error> {
+                    if (m_data.size() - m_position < length) {
+                        return decode_error("unexpected end of input");
+                    }
+                    auto const chunk = m_data.subspan(m_position, static_cast<usize>(length));
+                    for (auto const byte : chunk) {
+                        bytes.push_back(static_cast<char>(byte));
+                    }
+                    m_position += chunk.size();
+                    return std::monostate{};
+                };
+
+                if (head.additional_information != indefinite_length) {
+                    if (auto const result = append_chunk(head.argument); not result.has_value()) {
+                        return std::unexpected{ result.error() };
+                    }
+                } else {
+                    while (not is_at_break()) {
+                        auto const chunk_head = this->head();
+                        if (not chunk_head.has_value()) {
+                            return std::unexpected{ chunk_head.error() };
+                        }
+                        if (chunk_head->type != MajorType::TextString
+                            or chunk_head->additional_information == indefinite_length) {
+                            return decode_error("invalid chunk in indefinite length text string");
+                        }
+                        if (auto const result = append_chunk(chunk_head->argument); not result.has_value()) {
+                            return std::unexpected{ result.error() };
+                        }
+                    }
+                    ++m_position;  // skip break
+                }
+                if (not detail::is_valid_utf8(bytes)) {
+                    return decode_error("text string is not valid UTF-8");
+                }
+                return Utf8String{ std::move(bytes) };
+            }
+
+            [[nodiscard]] std::expected<ValuePointer, Error> array(Head const& head) {
+                auto elements = Array::Elements{};
+                if (head.additional_information != indefinite_length) {
+                    // every element takes at least one byte, so the length can't exceed the remaining input
+                    if (head.argument > m_data.size() - m_position) {
+                        return decode_error("unexpected end of input");
+                    }
+                    elements.reserve(static_cast<usize>(head.argument));
+                }
+                for (auto i = u64{ 0 }; is_indefinite_or_below(head, i); ++i) {
+                    if (head.additional_information == indefinite_length and is_at_break()) {
+                        ++m_position;  // skip break
+                        break;
+                    }
+                    auto element = value();
+                    if (not element.has_value()) {
+                        return std::unexpected{ element.error() };
+                    }
+                    elements.push_back(std::move(element).value());
+                }
+                return std::make_unique<Array>(std::move(elements));
+            }
+
+            [[nodiscard]] std::expected<ValuePointer, Error> map(Head const& head) {
+                auto values = Object::Members{};
+                if (head.additional_information != indefinite_length) {
+                    // every key and every value take at least one byte each
+                    if (head.argument > (m_data.size() - m_position) / 2) {
+                        return decode_error("unexpected end of input");
+                    }
+                    values.reserve(static_cast<usize>(head.argument));
+                }
+                for (auto i = u64{ 0 }; is_indefinite_or_below(head, i); ++i) {
+                    if (head.additional_information == indefinite_length and is_at_break()) {
+                        ++m_position;  // skip break
+                        break;
+                    }
+                    auto const key_head = this->head();
+                    if (not key_head.has_value()) {
+                        return std::unexpected{ key_head.error() };
+                    }
+                    if (key_head->type != MajorType::TextString) {
+                        return decode_error("map keys must be text strings");
+                    }
+                    auto key = text_string(key_head.value());
+                    if (not key.has_value()) {
+                        return std::unexpected{ key.error() };
+                    }
+                    auto member_value = value();
+                    if (not member_value.has_value()) {
+                        return std::unexpected{ member_value.error() };
+                    }
+                    values.emplace_back(String{ std::move(key).value() }, std::move(member_value).value());
+                }
+                auto keys = std::unordered_set<Utf8StringView>{};
+                for (auto const& key : values | std::views::keys) {
+                    if (auto&& [_, inserted] = keys.insert(key.value.view()); not inserted) {
+                        return decode_error(std::format("duplicate key: {}", key.value.c_str()));
+                    }
+                }
+                return std::make_unique<Object>(std::move(values));
+            }
+
+            [[nodiscard]] static bool is_indefinite_or_below(Head const& head, u64 const index) {
+                return head.additional_information == indefinite_length or index < head.argument;
+            }
+
+            [[nodiscard]] std::expected<ValuePointer, Error> simple_value(Head const& head) {
+                auto number = double{};
+                switch (head.additional_information) {
+                    case 20:
+                        return std::make_unique<Boolean>(false);
+                    case 21:
+                        return std::make_unique<Boolean>(true);
+                    case 22:
+                        return std::make_unique<Null>();
+                    case 25:
+                        number = half_to_double(static_cast<u16>(head.argument));
+                        break;
+                    case 26:
+                        number = static_cast<double>(std::bit_cast<float>(static_cast<u32>(head.argument)));
+                        break;
+                    case 27:
+                        number = std::bit_cast<double>(head.argument);
+                        break;
+                    default:
+                        return decode_error("unsupported simple value");
+                }
+                if (not std::isfinite(number)) {
+                    return decode_error("non-finite numbers are not supported");
+                }
+                return std::make_unique<Number>(number);
+            }
+
+            [[nodiscard]] static double half_to_double(u16 const half) {
+                auto const exponent = (half >> 10) & 0x1F;
+                auto const mantissa = half & 0x3FF;
+                auto const magnitude = [&] {
+                    if (exponent == 0) {
+                        return std::ldexp(mantissa, -24);
+                    }
+                    if (exponent == 31) {
+                        return mantissa == 0 ? std::numeric_limits<double>::infinity()
+                                             : std::numeric_limits<double>::quiet_NaN();
+                    }
+                    return std::ldexp(mantissa + 1024, exponent - 25);
+                }();
+                return (half & 0x8000) != 0 ? -magnitude : magnitude;
+            }
+        };
+    }  // namespace
+
+    [[nodiscard]] std::vector<std::byte> to_cbor(Value const& value) {
+        return Encoder{}.encode(value);
+    }
+
+    [[nodiscard]] std::expected<ValuePointer, Error> from_cbor(std::span<std::byte const> const data) {
+        auto decoder = Decoder{ data };
+        return decoder.decode();
+    }
+}  // namespace c2k::json
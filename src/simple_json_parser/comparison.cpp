@@ -0,0 +1,167 @@
+#include <bit>
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/boolean.hpp>
+#include <simple_json_parser/detail/comparison.hpp>
+#include <simple_json_parser/detail/number.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/string.hpp>
+#include <unordered_map>
+
+namespace c2k::json {
+    namespace {
+        // objects up to this size are compared without building a lookup table
+        constexpr auto max_linear_lookup_size = usize{ 8 };
+
+        [[nodiscard]] bool objects_equal(Object const& lhs, Object const& rhs, CompareOptions const& options) {
+            if (not options.ignore_member_order) {
+                for (auto i = usize{ 0 }; i < lhs.values.size(); ++i) {
+                    auto const& [lhs_key, lhs_value] = lhs.values.at(i);
+                    auto const& [rhs_key, rhs_value] = rhs.values.at(i);
+                    if (lhs_key.value != rhs_key.value or not equals(*lhs_value, *rhs_value, options)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            if (lhs.values.size() <= max_linear_lookup_size) {
+                for (auto const& [lhs_key, lhs_value] : lhs.values) {
+                    auto const rhs_member =
+                        std::ranges::find(rhs.values, lhs_key.value, [](auto const& member) -> Utf8String const& {
+                            return member.first.value;
+                        });
+                    if (rhs_member == rhs.values.cend() or not equals(*lhs_value, *rhs_member->second, options)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            auto rhs_members = std::unordered_map<Utf8StringView, Value const*>{};
+            rhs_members.reserve(rhs.values.size());
+            for (auto const& [key, value] : rhs.values) {
+                rhs_members.emplace(key.value.view(), value.get());
+            }
+            for (auto const& [lhs_key, lhs_value] : lhs.values) {
+                auto const rhs_member = rhs_members.find(lhs_key.value.view());
+                if (rhs_member == rhs_members.cend() or not equals(*lhs_value, *rhs_member->second, options)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // finalizer of SplitMix64, used to spread the bits of the combined hashes
+        [[nodiscard]] constexpr u64 mix(u64 value) {
+            value ^= value >> 30;
+            value *= u64{ 0xBF58476D1CE4E5B9 };
+            value ^= value >> 27;
+            value *= u64{ 0x94D049BB133111EB };
+            value ^= value >> 31;
+            return value;
+        }
+
+        [[nodiscard]] constexpr u64 combine(u64 const seed, u64 const value) {
+            return mix(seed ^ (value + u64{ 0x9E3779B97F4A7C15 } + (seed << 6) + (seed >> 2)));
+        }
+
+        // distinct seeds per type, so that e.g. `[]` and `{}` don't collide
+        enum class TypeSeed : u64 {
+            Null = 0x6E756C6C,
+            Boolean = 0x626F6F6C,
+            Number = 0x6E756D62,
+            String = 0x73747269,
+            Array = 0x61727261,
+            Object = 0x6F626A65,
+        };
+
+        [[nodiscard]] u64 string_hash(Utf8String const& string) {
+            // FNV-1a over the UTF-8 bytes
+            auto hash = u64{ 0xCBF29CE484222325 };
+            for (auto const c : string) {
+                for (auto const byte : c.as_string_view()) {
+                    hash ^= static_cast<u64>(static_cast<unsigned char>(byte));
+                    hash *= u64{ 0x100000001B3 };
+                }
+            }
+            return combine(std::to_underlying(TypeSeed::String), hash);
+        }
+    }  // namespace
+
+    [[nodiscard]] bool equals(Value const& lhs, Value const& rhs, CompareOptions const& options) {
+        if (&lhs == &rhs) {
+            return true;
+        }
+        if (auto const lhs_object = lhs.as_object()) {
+            auto const rhs_object = rhs.as_object();
+            if (not rhs_object or lhs_object->values.size() != rhs_object->values.size()) {
+                return false;
+            }
+            return &*lhs_object == &*rhs_object or objects_equal(*lhs_object, *rhs_object, options);
+        }
+        if (auto const lhs_array = lhs.as_array()) {
+            auto const rhs_array = rhs.as_array();
+            if (not rhs_array or lhs_array->elements.size() != rhs_array->elements.size()) {
+                return false;
+            }
+            if (&*lhs_array == &*rhs_array) {
+                return true;
+            }
+            return std::ranges::equal(
+                lhs_array->elements,
+                rhs_array->elements,
+                [&](auto const& left, auto const& right) { return equals(*left, *right, options); }
+            );
+        }
+        if (auto const lhs_string = lhs.as_string()) {
+            auto const rhs_string = rhs.as_string();
+            return rhs_string and lhs_string->value == rhs_string->value;
+        }
+        if (auto const lhs_number = lhs.as_number()) {
+            auto const rhs_number = rhs.as_number();
+            return rhs_number and lhs_number->value == rhs_number->value;
+        }
+        if (auto const lhs_boolean = lhs.as_boolean()) {
+            auto const rhs_boolean = rhs.as_boolean();
+            return rhs_boolean and lhs_boolean->value == rhs_boolean->value;
+        }
+        return lhs.is_null() and rhs.is_null();
+    }
+
+    [[nodiscard]] u64 structural_hash(Value const& value, CompareOptions const& options) {
+        if (auto const object = value.as_object()) {
+            auto hash = combine(std::to_underlying(TypeSeed::Object), object->values.size());
+            if (options.ignore_member_order) {
+                // summing up the member hashes makes the result independent of the order
+                auto sum = u64{ 0 };
+                for (auto const& [key, member_value] : object->values) {
+                    sum += combine(string_hash(key.value), structural_hash(*member_value, options));
+                }
+                return combine(hash, sum);
+            }
+            for (auto const& [key, member_value] : object->values) {
+                hash = combine(combine(hash, string_hash(key.value)), structural_hash(*member_value, options));
+            }
+            return hash;
+        }
+        if (auto const array = value.as_array()) {
+            auto hash = combine(std::to_underlying(TypeSeed::Array), array->elements.size());
+            for (auto const& element : array->elements) {
+                hash = combine(hash, structural_hash(*element, options));
+            }
+            return hash;
+        }
+        if (auto const string = value.as_string()) {
+            return string_hash(string->value);
+        }
+        if (auto const number = value.as_number()) {
+            // 0.0 and -0.0 compare equal and therefore have to hash equally
+            auto const normalized = number->value == 0.0 ? 0.0 : number->value;
+            return combine(std::to_underlying(TypeSeed::Number), std::bit_cast<u64>(normalized));
+        }
+        if (auto const boolean = value.as_boolean()) {
+            return combine(std::to_underlying(TypeSeed::Boolean), boolean->value ? 1 : 0);
+        }
+        return mix(std::to_underlying(TypeSeed::Null));
+    }
+}  // namespace c2k::json
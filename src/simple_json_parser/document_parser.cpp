@@ -0,0 +1,20 @@
+#include <simple_json_parser/detail/document_parser.hpp>
+#include <simple_json_parser/detail/parser.hpp>
+
+namespace c2k::json {
+    [[nodiscard]] std::expected<ValuePointer, Error> DocumentParser::parse(Utf8StringView const input) {
+        auto parser = detail::Parser{ input, m_state, m_options };
+        return parser.parse();
+    }
+
+    [[nodiscard]] std::vector<std::expected<ValuePointer, Error>> DocumentParser::parse_batch(
+        std::span<Utf8StringView const> const inputs
+    ) {
+        auto results = std::vector<std::expected<ValuePointer, Error>>{};
+        results.reserve(inputs.size());
+        for (auto const input : inputs) {
+            results.push_back(parse(input));
+        }
+        return results;
+    }
+}  // namespace c2k::json
@@ -0,0 +1,106 @@
+#include <format>
+#include <simple_json_parser/detail/errors.hpp>
+
+namespace c2k::json {
+    namespace {
+        [[nodiscard]] std::string describe(ParseError const& error) {
+            switch (error.code) {
+                case ParseErrorCode::UnexpectedEndOfInput:
+                    return "unexpected end of input";
+                case ParseErrorCode::UnexpectedCharacter:
+                    return "unexpected character";
+                case ParseErrorCode::ExpectedCharacter:
+                    return std::format("expected '{}'", error.expected);
+                case ParseErrorCode::InvalidCharacterInString:
+                    return "invalid character in string";
+                case ParseErrorCode::InvalidEscapeSequence:
+                    return "invalid escape sequence";
+                case ParseErrorCode::InvalidUnicodeEscapeSequence:
+                    return "invalid unicode escape sequence";
+                case ParseErrorCode::InvalidSurrogatePair:
+                    return "invalid surrogate pair";
+                case ParseErrorCode::InvalidHexDigit:
+                    return "invalid hex digit";
+                case ParseErrorCode::ExpectedDigit:
+                    return "expected digit";
+                case ParseErrorCode::NumberOutOfRange:
+                    return "number out of range";
+                case ParseErrorCode::IntegerOutOfRange:
+                    return "integer out of range";
+                case ParseErrorCode::UnexpectedNegativeInteger:
+                    return "unexpected negative integer";
+                case ParseErrorCode::ExpectedNull:
+                    return "expected 'null'";
+                case ParseErrorCode::ExpectedTrue:
+                    return "expected 'true'";
+                case ParseErrorCode::ExpectedFalse:
+                    return "expected 'false'";
+                case ParseErrorCode::DuplicateKey:
+                    return "duplicate key";
+                case ParseErrorCode::MaximumDepthExceeded:
+                    return "maximum nesting depth exceeded";
+                case ParseErrorCode::TooManyNodes:
+                    return "maximum number of values exceeded";
+                case ParseErrorCode::TooManyMembers:
+                    return "maximum number of object members exceeded";
+                case ParseErrorCode::StringTooLong:
+                    return "maximum string length exceeded";
+                case ParseErrorCode::NumberTooLong:
+                    return "maximum number length exceeded";
+                case ParseErrorCode::MemoryLimitExceeded:
+                    return "memory limit exceeded";
+                case ParseErrorCode::InvalidUtf8:
+                    return "invalid UTF-8";
+            }
+            return "unknown error";
+        }
+
+        [[nodiscard]] bool has_offending_character(ParseErrorCode const code) {
+            return code == ParseErrorCode::UnexpectedCharacter or code == ParseErrorCode::InvalidCharacterInString
+                   or code == ParseErrorCode::ExpectedCharacter;
+        }
+    }  // namespace
+
+    [[nodiscard]] std::string ParseError::message() const {
+        return std::format("{} at byte offset {}", describe(*this), offset);
+    }
+
+    [[nodiscard]] std::string ParseError::message(Utf8StringView const input) const {
+        auto const [line, column] = location(input);
+        auto result = std::format("{} at line {}, column {}", describe(*this), line, column);
+        if (not has_offending_character(code)) {
+            return result;
+        }
+        // find the character at the error position
+        auto iterator = input.cbegin();
+        for (auto num_bytes = usize{ 0 }; iterator != input.cend() and num_bytes < offset; ++iterator) {
+            num_bytes += (*iterator).as_string_view().size();
+        }
+        if (iterator == input.cend()) {
+            return result;
+        }
+        auto const character = *iterator;
+        if (character.codepoint() < 0x20) {
+            return std::format("{} (found U+{:04X})", result, character.codepoint());
+        }
+        return std::format("{} (found '{}')", result, character.as_string_view());
+    }
+
+    [[nodiscard]] SourceLocation ParseError::location(Utf8StringView const input) const {
+        auto location = SourceLocation{ 1, 1 };
+        auto num_bytes = usize{ 0 };
+        for (auto const c : input) {
+            if (num_bytes >= offset) {
+                break;
+            }
+            num_bytes += c.as_string_view().size();
+            if (c == '\n') {
+                ++location.line;
+                location.column = 1;
+            } else {
+                ++location.column;
+            }
+        }
+        return location;
+    }
+}  // namespace c2k::json
@@ -0,0 +1,147 @@
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/formatter.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/parser.hpp>
+#include <simple_json_parser/detail/string.hpp>
+
+namespace c2k::json {
+    namespace {
+        using namespace c2k::Utf8Literals;
+
+        void append_compact(Value const& value, Utf8String& result) {
+            if (auto const object = value.as_object()) {
+                result += '{';
+                for (auto i = usize{ 0 }; i < object->values.size(); ++i) {
+                    auto const& [key, member_value] = object->values.at(i);
+                    if (i > 0) {
+                        result += ',';
+                    }
+                    detail::append_escaped(key.value, result);
+                    result += ':';
+                    append_compact(*member_value, result);
+                }
+                result += '}';
+                return;
+            }
+            if (auto const array = value.as_array()) {
+                result += '[';
+                for (auto i = usize{ 0 }; i < array->elements.size(); ++i) {
+                    if (i > 0) {
+                        result += ',';
+                    }
+                    append_compact(*array->elements.at(i), result);
+                }
+                result += ']';
+                return;
+            }
+            if (auto const string = value.as_string()) {
+                detail::append_escaped(string->value, result);
+                return;
+            }
+            result += value.format(0, 0);
+        }
+
+        [[nodiscard]] bool is_whitespace(Utf8Char const c) {
+            return c == 0x20 or c == 0x0A or c == 0x0D or c == 0x09;
+        }
+
+        // Copies the tokens of `input`, which has to consist of a single valid value, `indentation_step` is ignored
+        // if the output is not indented.
+        [[nodiscard]] Utf8String reformat(Utf8StringView const input, bool const indent, usize const indentation_step) {
+            auto result = Utf8String{};
+            auto depth = usize{ 0 };
+            auto const new_line = [&] {
+                result += '\n';
+                for (auto i = usize{ 0 }; i < depth * indentation_step; ++i) {
+                    result += ' ';
+                }
+            };
+
+            auto iterator = input.cbegin();
+            auto const skip_whitespace = [&] {
+                while (iterator != input.cend() and is_whitespace(*iterator)) {
+                    ++iterator;
+                }
+            };
+
+            skip_whitespace();
+            while (iterator != input.cend()) {
+                auto const c = *iterator;
+                ++iterator;
+                if (c == '"') {
+                    result += c;
+                    auto is_escaped = false;
+                    while (iterator != input.cend()) {
+                        auto const string_character = *iterator;
+                        ++iterator;
+                        result += string_character;
+                        if (is_escaped) {
+                            is_escaped = false;
+                        } else if (string_character == '\\') {
+                            is_escaped = true;
+                        } else if (string_character == '"') {
+                            break;
+                        }
+                    }
+                } else if (c == '{' or c == '[') {
+                    result += c;
+                    skip_whitespace();
+                    if (*iterator == '}' or *iterator == ']') {
+                        // empty containers stay on a single line
+                        result += *iterator;
+                        ++iterator;
+                    } else {
+                        ++depth;
+                        if (indent) {
+                            new_line();
+                        }
+                    }
+                } else if (c == '}' or c == ']') {
+                    --depth;
+                    if (indent) {
+                        new_line();
+                    }
+                    result += c;
+                } else if (c == ',') {
+                    result += c;
+                    if (indent) {
+                        new_line();
+                    }
+                } else if (c == ':') {
+                    result += indent ? ": " : ":";
+                } else if (not is_whitespace(c)) {
+                    // part of a number or a literal
+                    result += c;
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] std::expected<Utf8String, Error> reformat_checked(
+            Utf8StringView const input,
+            bool const indent,
+            usize const indentation_step
+        ) {
+            auto validator = detail::Validator{ input, detail::NullSink{ true } };
+            if (auto const result = validator.parse(); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
+            // anything after the root value is ignored, like `parse()` does
+            return reformat(Utf8StringView{ input.cbegin(), validator.position() }, indent, indentation_step);
+        }
+    }  // namespace
+
+    [[nodiscard]] Utf8String to_compact_string(Value const& value) {
+        auto result = Utf8String{};
+        append_compact(value, result);
+        return result;
+    }
+
+    [[nodiscard]] std::expected<Utf8String, Error> minify(Utf8StringView const input) {
+        return reformat_checked(input, false, 0);
+    }
+
+    [[nodiscard]] std::expected<Utf8String, Error> prettify(Utf8StringView const input, usize const indentation_step) {
+        return reformat_checked(input, true, indentation_step);
+    }
+}  // namespace c2k::json
@@ -3,11 +3,17 @@
 #include <concepts>
 #include <ranges>
 #include <vector>
+#include "small_vector.hpp"
 #include "value.hpp"
 
 namespace c2k::json {
     struct Array final : Value {
-        std::vector<ValuePointer> elements;
+        // arrays with up to this many elements don't need a separate allocation for them
+        static constexpr auto inline_capacity = usize{ 4 };
+
+        using Elements = detail::SmallVector<ValuePointer, inline_capacity>;
+
+        Elements elements;
 
         Array() = default;
 
@@ -17,9 +23,19 @@ namespace c2k::json {
             (this->elements.emplace_back(std::forward<decltype(elements)>(elements)), ...);
         }
 
+        explicit Array(Elements elements)
+            : elements{ std::move(elements) } {}
+
         explicit Array(std::vector<ValuePointer> elements)
             : elements{ std::move(elements) } {}
 
+        // the elements are owned exclusively, use `clone()` for a deep copy
+        Array(Array const&) = delete;
+        Array(Array&&) noexcept = default;
+        Array& operator=(Array const&) = delete;
+        Array& operator=(Array&&) noexcept = default;
+        ~Array() override = default;
+
         [[nodiscard]] bool is_array() const override {
             return true;
         }
@@ -54,5 +70,14 @@ namespace c2k::json {
             result += ']';
             return result;
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            auto copied_elements = Elements{};
+            copied_elements.reserve(elements.size());
+            for (auto const& element : elements) {
+                copied_elements.push_back(element->clone());
+            }
+            return std::make_unique<Array>(std::move(copied_elements));
+        }
     };
 }  // namespace c2k::json
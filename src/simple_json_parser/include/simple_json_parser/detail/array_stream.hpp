@@ -0,0 +1,84 @@
+#pragma once
+
+#include <expected>
+#include <iterator>
+#include <lib2k/utf8/string_view.hpp>
+#include <memory>
+#include <tl/optional.hpp>
+#include "errors.hpp"
+#include "parser_state.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    namespace detail {
+        template<typename Sink>
+        class BasicParser;
+        class TreeSink;
+        using Parser = BasicParser<TreeSink>;
+    }  // namespace detail
+
+    // Parses the elements of a root array one at a time, so that only a single element has to be kept in memory
+    // instead of the whole array. The previous element is released before the next one is parsed. If an element
+    // fails to parse, the error is returned in its place and the iteration ends. The input has to outlive the
+    // stream.
+    class ArrayStream final {
+        detail::ParserState m_state;
+        std::unique_ptr<detail::Parser> m_parser;
+        tl::optional<std::expected<ValuePointer, Error>> m_current;
+        bool m_has_started = false;
+        bool m_is_done = false;
+
+    public:
+        class Iterator final {
+            ArrayStream* m_stream = nullptr;
+
+        public:
+            using value_type = std::expected<ValuePointer, Error>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            explicit Iterator(ArrayStream& stream)
+                : m_stream{ &stream } {}
+
+            [[nodiscard]] value_type& operator*() const {
+                return m_stream->m_current.value();
+            }
+
+            Iterator& operator++() {
+                m_stream->advance();
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            [[nodiscard]] bool operator==(std::default_sentinel_t) const {
+                return not m_stream->m_current.has_value();
+            }
+        };
+
+        explicit ArrayStream(Utf8StringView input);
+
+        // the parser refers to the scratch buffers of this instance
+        ArrayStream(ArrayStream const&) = delete;
+        ArrayStream(ArrayStream&&) = delete;
+        ArrayStream& operator=(ArrayStream const&) = delete;
+        ArrayStream& operator=(ArrayStream&&) = delete;
+        ~ArrayStream();
+
+        // returns the next element, or `tl::nullopt` after the last one
+        [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> next();
+
+        // can only be iterated once, and not after `next()` has been used
+        [[nodiscard]] Iterator begin();
+
+        [[nodiscard]] std::default_sentinel_t end() const {
+            return std::default_sentinel;
+        }
+
+    private:
+        void advance();
+    };
+}  // namespace c2k::json
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <expected>
+#include <lib2k/types.hpp>
+#include <string>
+#include <string_view>
+#include <tl/optional.hpp>
+#include <utility>
+#include "errors.hpp"
+#include "parser_state.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    // A source of bytes that is read asynchronously. `read()` has to return an awaitable that produces the next
+    // chunk of input as something convertible to `std::string_view`, an empty chunk signals the end of the input.
+    // A chunk only has to stay valid until `read()` is called again.
+    template<typename T>
+    concept AsyncByteSource = requires(T& source) { source.read(); };
+
+    namespace detail {
+        // Splits an array that arrives in chunks into its elements and parses each of them as soon as it is
+        // complete. Documents whose root is not an array are buffered and parsed as a whole at the end.
+        class IncrementalArrayParser final {
+            enum class Phase {
+                BeforeArray,
+                InArray,
+                WholeDocument,
+                Done,
+            };
+
+            Phase m_phase = Phase::BeforeArray;
+            // received input, the part from `m_buffer_start` on hasn't been consumed yet and always starts at the
+            // beginning of the current element
+            std::string m_buffer;
+            usize m_buffer_start = 0;
+            // total number of consumed bytes, used for error offsets
+            usize m_num_consumed_bytes = 0;
+            // position of the scan within the unconsumed input, offsets passed to `fail()` are relative to it too
+            usize m_scan_position = 0;
+            usize m_depth = 0;
+            bool m_is_in_string = false;
+            bool m_is_escaped = false;
+            bool m_is_end_of_input = false;
+            usize m_num_elements = 0;
+            ParserState m_state;
+
+        public:
+            void feed(std::string_view const chunk) {
+                // the consumed input is only dropped here so that consuming many small elements stays linear
+                m_buffer.erase(0, m_buffer_start);
+                m_buffer_start = 0;
+                m_buffer += chunk;
+            }
+
+            void finish() {
+                m_is_end_of_input = true;
+            }
+
+            [[nodiscard]] bool is_done() const {
+                return m_phase == Phase::Done;
+            }
+
+            // Returns the next value, or `tl::nullopt` if more input is needed or all values have been returned.
+            // After `finish()` has been called, `tl::nullopt` is only returned if all values have been returned.
+            [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> next();
+
+        private:
+            [[nodiscard]] std::string_view unconsumed() const {
+                return std::string_view{ m_buffer }.substr(m_buffer_start);
+            }
+
+            void consume(usize const num_bytes) {
+                m_buffer_start += num_bytes;
+                m_num_consumed_bytes += num_bytes;
+            }
+
+            [[nodiscard]] tl::optional<std::expected<ValuePointer, Error>> next_element();
+            [[nodiscard]] std::expected<ValuePointer, Error> parse_element(
+                std::string_view text,
+                bool is_array_element
+            );
+            [[nodiscard]] std::expected<ValuePointer, Error> fail(ParseErrorCode code, usize offset);
+        };
+    }  // namespace detail
+
+    // Coroutine that yields the values of a document as soon as they are complete. Use it from another coroutine
+    // via `co_await stream.next()`, which returns `tl::nullopt` after the last value. If a value fails to parse, the
+    // error is returned in its place and the stream ends.
+    class AsyncValueStream final {
+    public:
+        using Item = std::expected<ValuePointer, Error>;
+
+        struct promise_type;
+
+    private:
+        using Handle = std::coroutine_handle<promise_type>;
+
+        // suspends the stream and continues with the coroutine that is waiting for the next value
+        struct TransferToConsumer final {
+            [[nodiscard]] bool await_ready() const noexcept {
+                return false;
+            }
+
+            [[nodiscard]] std::coroutine_handle<> await_suspend(Handle const handle) const noexcept {
+                return handle.promise().consumer;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+    public:
+        struct promise_type final {
+            tl::optional<Item> current;
+            std::coroutine_handle<> consumer;
+            std::exception_ptr exception;
+
+            [[nodiscard]] AsyncValueStream get_return_object() {
+                return AsyncValueStream{ Handle::from_promise(*this) };
+            }
+
+            [[nodiscard]] std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            [[nodiscard]] TransferToConsumer final_suspend() const noexcept {
+                return {};
+            }
+
+            [[nodiscard]] TransferToConsumer yield_value(Item item) {
+                current = std::move(item);
+                return {};
+            }
+
+            void return_void() const noexcept {}
+
+            void unhandled_exception() {
+                exception = std::current_exception();
+            }
+        };
+
+        class NextAwaiter final {
+            Handle m_handle;
+
+        public:
+            explicit NextAwaiter(Handle const handle)
+                : m_handle{ handle } {}
+
+            [[nodiscard]] bool await_ready() const noexcept {
+                return m_handle.done();
+            }
+
+            [[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<> const consumer) const noexcept {
+                m_handle.promise().consumer = consumer;
+                m_handle.promise().current = tl::nullopt;
+                return m_handle;
+            }
+
+            [[nodiscard]] tl::optional<Item> await_resume() const {
+                auto& promise = m_handle.promise();
+                if (promise.exception) {
+                    std::rethrow_exception(std::exchange(promise.exception, nullptr));
+                }
+                if (m_handle.done()) {
+                    return tl::nullopt;
+                }
+                return std::exchange(promise.current, tl::nullopt);
+            }
+        };
+
+        AsyncValueStream(AsyncValueStream const&) = delete;
+
+        AsyncValueStream(AsyncValueStream&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) } {}
+
+        AsyncValueStream& operator=(AsyncValueStream const&) = delete;
+
+        AsyncValueStream& operator=(AsyncValueStream&& other) noexcept {
+            if (this != &other) {
+                destroy();
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~AsyncValueStream() {
+            destroy();
+        }
+
+        [[nodiscard]] NextAwaiter next() const {
+            return NextAwaiter{ m_handle };
+        }
+
+    private:
+        Handle m_handle;
+
+        explicit AsyncValueStream(Handle const handle)
+            : m_handle{ handle } {}
+
+        void destroy() {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+    };
+
+    // Parses the document provided by `source` while it's being read. If the root is an array, each of its
+    // elements is yielded as soon as it's complete, so that neither a thread is blocked waiting for input nor the
+    // whole document has to be buffered. Any other root is yielded as a single value after the input has ended.
+    // `source` has to outlive the returned stream.
+    template<AsyncByteSource Source>
+    [[nodiscard]] AsyncValueStream parse_async(Source& source) {
+        auto parser = detail::IncrementalArrayParser{};
+        while (not parser.is_done()) {
+            if (auto value = parser.next()) {
+                auto const has_failed = not value->has_value();
+                co_yield std::move(value).value();
+                if (has_failed) {
+                    co_return;
+                }
+                continue;
+            }
+            if (parser.is_done()) {
+                break;
+            }
+            // the awaited result may own the chunk (e.g. a `std::string`), so it has to outlive the view
+            auto const chunk = co_await source.read();
+            if (auto const view = std::string_view{ chunk }; view.empty()) {
+                parser.finish();
+            } else {
+                parser.feed(view);
+            }
+        }
+    }
+}  // namespace c2k::json
@@ -25,5 +25,9 @@ namespace c2k::json {
             using namespace c2k::Utf8Literals;
             return value ? "true"_utf8 : "false"_utf8;
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            return std::make_unique<Boolean>(value);
+        }
     };
 }  // namespace c2k::json
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <vector>
+#include "errors.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    // Encodes `value` as CBOR (RFC 8949). Integral numbers are encoded as integers, all other numbers as single
+    // precision floats if that's lossless and as double precision floats otherwise.
+    [[nodiscard]] std::vector<std::byte> to_cbor(Value const& value);
+
+    // Decodes a single CBOR data item. Only items that have a JSON equivalent are supported, i.e. byte strings,
+    // `undefined`, non-finite floats and map keys other than text strings are rejected. Tags are ignored.
+    [[nodiscard]] std::expected<ValuePointer, Error> from_cbor(std::span<std::byte const> data);
+}  // namespace c2k::json
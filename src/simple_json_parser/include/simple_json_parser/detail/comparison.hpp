@@ -0,0 +1,23 @@
+#pragma once
+
+#include <lib2k/types.hpp>
+#include "value.hpp"
+
+namespace c2k::json {
+    struct CompareOptions final {
+        // if set, objects with the same members in a different order are considered equal (and hash equally)
+        bool ignore_member_order = false;
+    };
+
+    // Compares two trees structurally. The comparison stops at the first difference and doesn't descend into
+    // containers of different sizes.
+    [[nodiscard]] bool equals(Value const& lhs, Value const& rhs, CompareOptions const& options = {});
+
+    // Calculates a hash of the tree that only depends on its contents, i.e. it's the same across runs and
+    // platforms. Values that are equal according to `equals()` (with the same options) have the same hash.
+    [[nodiscard]] u64 structural_hash(Value const& value, CompareOptions const& options = {});
+
+    [[nodiscard]] inline bool operator==(Value const& lhs, Value const& rhs) {
+        return equals(lhs, rhs);
+    }
+}  // namespace c2k::json
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <expected>
+#include <lib2k/utf8/string_view.hpp>
+#include <span>
+#include <vector>
+#include "errors.hpp"
+#include "options.hpp"
+#include "parser_state.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    // Parses independent documents one after another. In contrast to `parse()`, the scratch buffers of the parser
+    // are kept between documents, which avoids most of the allocations that are not part of the resulting
+    // `Value` trees. A `DocumentParser` must not be used by multiple threads at the same time. The limits in
+    // `options` apply to each document separately.
+    class DocumentParser final {
+        detail::ParserState m_state;
+        ParseOptions m_options;
+
+    public:
+        DocumentParser() = default;
+
+        explicit DocumentParser(ParseOptions const& options)
+            : m_options{ options } {}
+
+        [[nodiscard]] std::expected<ValuePointer, Error> parse(Utf8StringView input);
+
+        [[nodiscard]] std::vector<std::expected<ValuePointer, Error>> parse_batch(
+            std::span<Utf8StringView const> inputs
+        );
+    };
+}  // namespace c2k::json
@@ -1,12 +1,94 @@
 #pragma once
 
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string_view.hpp>
 #include <string>
 #include <variant>
 
 namespace c2k::json {
+    enum class ParseErrorCode : u8 {
+        UnexpectedEndOfInput,
+        UnexpectedCharacter,
+        ExpectedCharacter,
+        InvalidCharacterInString,
+        InvalidEscapeSequence,
+        InvalidUnicodeEscapeSequence,
+        InvalidSurrogatePair,
+        InvalidHexDigit,
+        ExpectedDigit,
+        NumberOutOfRange,
+        IntegerOutOfRange,
+        UnexpectedNegativeInteger,
+        ExpectedNull,
+        ExpectedTrue,
+        ExpectedFalse,
+        DuplicateKey,
+        MaximumDepthExceeded,
+        TooManyNodes,
+        TooManyMembers,
+        StringTooLong,
+        NumberTooLong,
+        MemoryLimitExceeded,
+        InvalidUtf8,
+    };
+
+    // both are 1-based, the column is counted in characters
+    struct SourceLocation final {
+        usize line;
+        usize column;
+    };
+
+    // Creating a `ParseError` never allocates, its message is only formatted when asked for.
     struct ParseError final {
-        std::string message;
+        ParseErrorCode code;
+        // number of bytes from the start of the input to the position at which the error has been detected
+        usize offset = 0;
+        // the missing character if `code` is `ParseErrorCode::ExpectedCharacter`
+        char expected = '\0';
+
+        [[nodiscard]] std::string message() const;
+
+        // same as `message()`, but includes the line, the column and the offending character, `input` has to be the
+        // input that has been parsed
+        [[nodiscard]] std::string message(Utf8StringView input) const;
+
+        [[nodiscard]] SourceLocation location(Utf8StringView input) const;
+    };
+
+    struct PatchError final {
+        std::string description;
+
+        [[nodiscard]] std::string message() const {
+            return description;
+        }
+    };
+
+    struct DecodeError final {
+        std::string description;
+
+        [[nodiscard]] std::string message() const {
+            return description;
+        }
+    };
+
+    // the schema passed to `Schema::compile()` is malformed or uses unsupported features
+    struct SchemaError final {
+        std::string description;
+
+        [[nodiscard]] std::string message() const {
+            return description;
+        }
+    };
+
+    // the document is well-formed, but violates the schema it has been parsed with
+    struct ValidationError final {
+        std::string description;
+
+        [[nodiscard]] std::string message() const {
+            return description;
+        }
     };
 
-    using Error = std::variant<ParseError>;
+    // every alternative provides `message()`, so it can be called via `std::visit()`
+    using Error = std::variant<ParseError, PatchError, DecodeError, SchemaError, ValidationError>;
 }  // namespace c2k::json
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <expected>
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include "errors.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    // Formats `value` without any whitespace, strings and numbers are formatted like `Value::pretty_print()` does.
+    [[nodiscard]] Utf8String to_compact_string(Value const& value);
+
+    // Removes all insignificant whitespace from the JSON text `input` without building a `Value` tree. The input
+    // is checked like `parse()` checks it, tokens are copied as is (e.g. escape sequences and numbers are not
+    // normalized).
+    [[nodiscard]] std::expected<Utf8String, Error> minify(Utf8StringView input);
+
+    // Same as `minify()`, but the output is indented in the same layout that `Value::pretty_print()` uses.
+    [[nodiscard]] std::expected<Utf8String, Error> prettify(Utf8StringView input, usize indentation_step = 2);
+}  // namespace c2k::json
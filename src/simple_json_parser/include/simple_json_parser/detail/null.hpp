@@ -12,5 +12,9 @@ namespace c2k::json {
             using namespace c2k::Utf8Literals;
             return "null"_utf8;
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            return std::make_unique<Null>();
+        }
     };
 }  // namespace c2k::json
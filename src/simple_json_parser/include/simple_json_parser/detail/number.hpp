@@ -36,5 +36,9 @@ namespace c2k::json {
             }
             return std::move(stream).str();
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            return std::make_unique<Number>(value);
+        }
     };
 }  // namespace c2k::json
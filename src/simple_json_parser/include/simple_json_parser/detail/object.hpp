@@ -5,6 +5,7 @@
 #include <stdexcept>
 #include <vector>
 #include <unordered_set>
+#include "small_vector.hpp"
 #include "string.hpp"
 #include "value.hpp"
 
@@ -15,8 +16,13 @@ namespace c2k::json {
     };
 
     struct Object final : Value {
+        // objects with up to this many members don't need a separate allocation for them
+        static constexpr auto inline_capacity = usize{ 2 };
+
+        using Members = detail::SmallVector<std::pair<String, ValuePointer>, inline_capacity>;
+
         // stored as a vector to preserve insertion order
-        std::vector<std::pair<String, ValuePointer>> values;
+        Members values;
 
         Object() = default;
 
@@ -33,9 +39,19 @@ namespace c2k::json {
             }
         }
 
+        explicit Object(Members values)
+            : values{ std::move(values) } {}
+
         explicit Object(std::vector<std::pair<String, ValuePointer>> values)
             : values{ std::move(values) } {}
 
+        // the values are owned exclusively, use `clone()` for a deep copy
+        Object(Object const&) = delete;
+        Object(Object&&) noexcept = default;
+        Object& operator=(Object const&) = delete;
+        Object& operator=(Object&&) noexcept = default;
+        ~Object() override = default;
+
         [[nodiscard]] bool is_object() const override {
             return true;
         }
@@ -73,5 +89,14 @@ namespace c2k::json {
             result += "}"_utf8;
             return result;
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            auto copied_values = Members{};
+            copied_values.reserve(values.size());
+            for (auto const& [key, value] : values) {
+                copied_values.emplace_back(key, value->clone());
+            }
+            return std::make_unique<Object>(std::move(copied_values));
+        }
     };
 }  // namespace c2k::json
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <lib2k/types.hpp>
+#include <tl/optional.hpp>
+
+namespace c2k::json {
+    struct ValidateOptions final {
+        // `parse()` always rejects duplicate keys, disabling this only checks the syntax
+        bool reject_duplicate_keys = true;
+        // maximum number of nested arrays and objects, unlimited if not set
+        tl::optional<usize> max_depth = tl::nullopt;
+    };
+
+    // Limits for parsing untrusted input, none of them are set by default. The parser fails as soon as one of them
+    // is exceeded.
+    struct ParseOptions final {
+        // maximum number of nested arrays and objects, this also bounds the stack usage of the parser
+        tl::optional<usize> max_depth = tl::nullopt;
+        // maximum number of values in the whole document, including the root and all nested values
+        tl::optional<usize> max_nodes = tl::nullopt;
+        // maximum length of a string (including object keys) in bytes after unescaping
+        tl::optional<usize> max_string_length = tl::nullopt;
+        tl::optional<usize> max_object_members = tl::nullopt;
+        // maximum length of the textual representation of a number in bytes
+        tl::optional<usize> max_number_length = tl::nullopt;
+        // maximum amount of memory in bytes that may be allocated for the resulting tree, the allocator's overhead
+        // is not taken into account; strings and containers are already rejected while they are being read
+        tl::optional<usize> max_memory = tl::nullopt;
+    };
+
+    struct ParallelParseOptions final {
+        // number of threads to use (including the calling thread), 0 selects `std::thread::hardware_concurrency()`
+        usize num_threads = 0;
+        // the input is never split into chunks smaller than this amount of bytes
+        usize min_chunk_size = usize{ 1 } << 20;
+    };
+}  // namespace c2k::json
@@ -13,49 +13,453 @@
 #include <simple_json_parser/detail/null.hpp>
 #include <simple_json_parser/detail/number.hpp>
 #include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/options.hpp>
+#include <simple_json_parser/detail/parser_state.hpp>
+#include <simple_json_parser/detail/schema.hpp>
 #include <simple_json_parser/detail/string.hpp>
 #include <simple_json_parser/detail/value.hpp>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 [[nodiscard]] inline std::expected<i32, c2k::json::Error> convert_surrogates_to_codepoint(
     u16 const high_surrogate,
     u16 const low_surrogate
 ) {
     if (high_surrogate < 0xD800 or high_surrogate > 0xDBFF or low_surrogate < 0xDC00 or low_surrogate > 0xDFFF) {
-        return std::unexpected{ c2k::json::ParseError{ "invalid surrogate pair" } };
+        return std::unexpected{ c2k::json::ParseError{ c2k::json::ParseErrorCode::InvalidSurrogatePair } };
     }
     return 0x10000 + ((high_surrogate - 0xD800) << 10) + (low_surrogate - 0xDC00);
 }
 
 namespace c2k::json::detail {
-    class Parser final {
+    // Builds the `Value` tree. The children of the containers that are being parsed are kept in `ParserState`.
+    class TreeSink final {
+        ParserState& m_state;
+        // records the text of every value if not `nullptr`
+        std::unordered_map<Value const*, Utf8StringView>* m_sources;
+
+    public:
+        using Node = ValuePointer;
+        using Text = Utf8String;
+
+        static constexpr auto builds_values = true;
+
+        // not explicit, so that a `Parser` can be created from a `ParserState` directly
+        TreeSink(ParserState& state, std::unordered_map<Value const*, Utf8StringView>* const sources = nullptr)
+            : m_state{ state }, m_sources{ sources } {}
+
+        [[nodiscard]] Node null() const {
+            return std::make_unique<Null>();
+        }
+
+        [[nodiscard]] Node boolean(bool const value) const {
+            return std::make_unique<Boolean>(value);
+        }
+
+        [[nodiscard]] Node number(double const value) const {
+            return std::make_unique<Number>(value);
+        }
+
+        [[nodiscard]] Node string(Text&& value) const {
+            return std::make_unique<String>(std::move(value));
+        }
+
+        void source(Node const& node, Utf8StringView const text) const {
+            if (m_sources != nullptr) {
+                m_sources->insert_or_assign(node.get(), text);
+            }
+        }
+
+        // returns the marker that has to be passed to `end_array()`
+        [[nodiscard]] usize begin_array() const {
+            return m_state.elements.size();
+        }
+
+        void element(Node&& node) {
+            m_state.elements.push_back(std::move(node));
+        }
+
+        [[nodiscard]] Node end_array(usize const first_element) {
+            return std::make_unique<Array>(take_elements(first_element));
+        }
+
+        // moves the elements of the innermost array from the scratch buffer into an exactly sized vector
+        [[nodiscard]] Array::Elements take_elements(usize const first_element) {
+            auto const elements = std::ranges::subrange{
+                m_state.elements.begin() + static_cast<std::ptrdiff_t>(first_element),
+                m_state.elements.end(),
+            };
+            auto result = Array::Elements{};
+            result.reserve(elements.size());
+            std::ranges::move(elements, std::back_inserter(result));
+            m_state.elements.erase(elements.begin(), elements.end());
+            return result;
+        }
+
+        // returns the marker that has to be passed to `has_duplicate_keys()` and `end_object()`
+        [[nodiscard]] usize begin_object() const {
+            return m_state.members.size();
+        }
+
+        void member(Text&& key, Node&& node) {
+            m_state.members.emplace_back(String{ std::move(key) }, std::move(node));
+        }
+
+        [[nodiscard]] bool has_duplicate_keys(usize const first_member) {
+            if (m_state.members.size() - first_member < 2) {
+                return false;
+            }
+            // equal keys have equal hashes, so after sorting only keys within runs of equal hashes have to be compared
+            auto& keys = m_state.keys;
+            keys.clear();
+            for (auto i = first_member; i < m_state.members.size(); ++i) {
+                auto const view = m_state.members.at(i).first.value.view();
+                keys.emplace_back(std::hash<Utf8StringView>{}(view), view);
+            }
+            std::ranges::sort(keys, {}, &std::pair<usize, Utf8StringView>::first);
+            for (auto it = keys.cbegin(); it != keys.cend(); ++it) {
+                for (auto other = it + 1; other != keys.cend() and other->first == it->first; ++other) {
+                    if (other->second == it->second) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] Node end_object(usize const first_member) {
+            auto const members = std::ranges::subrange{
+                m_state.members.begin() + static_cast<std::ptrdiff_t>(first_member),
+                m_state.members.end(),
+            };
+            auto values = Object::Members{};
+            values.reserve(members.size());
+            std::ranges::move(members, std::back_inserter(values));
+            m_state.members.erase(members.begin(), members.end());
+            return std::make_unique<Object>(std::move(values));
+        }
+
+        void clear() {
+            m_state.clear();
+        }
+    };
+
+    // Builds nothing, so parsing only checks the input. Strings aren't decoded, object keys are remembered by their
+    // raw (still escaped) text and only decoded when they are compared.
+    class NullSink final {
+        bool m_reject_duplicate_keys;
+        // hashes and raw texts of the keys of all objects that are currently open, the innermost object's keys
+        // come last
+        std::vector<std::pair<u64, Utf8StringView>> m_keys;
+
+    public:
+        using Node = std::monostate;
+        using Text = Utf8StringView;
+
+        static constexpr auto builds_values = false;
+
+        explicit NullSink(bool const reject_duplicate_keys)
+            : m_reject_duplicate_keys{ reject_duplicate_keys } {}
+
+        [[nodiscard]] Node null() const {
+            return Node{};
+        }
+
+        [[nodiscard]] Node boolean(bool) const {
+            return Node{};
+        }
+
+        [[nodiscard]] Node number(double) const {
+            return Node{};
+        }
+
+        [[nodiscard]] Node string(Text) const {
+            return Node{};
+        }
+
+        void source(Node, Utf8StringView) const {}
+
+        [[nodiscard]] usize begin_array() const {
+            return 0;
+        }
+
+        void element(Node) const {}
+
+        [[nodiscard]] Node end_array(usize) const {
+            return Node{};
+        }
+
+        [[nodiscard]] usize begin_object() const {
+            return m_keys.size();
+        }
+
+        void member(Text const key, Node) {
+            if (m_reject_duplicate_keys) {
+                m_keys.emplace_back(hash_key(key), key);
+            }
+        }
+
+        [[nodiscard]] bool has_duplicate_keys(usize const first_key) {
+            auto const keys = std::ranges::subrange{
+                m_keys.begin() + static_cast<std::ptrdiff_t>(first_key),
+                m_keys.end(),
+            };
+            // equal keys have equal hashes, so after sorting only keys within runs of equal hashes have to be compared
+            std::ranges::sort(keys, {}, &std::pair<u64, Utf8StringView>::first);
+            for (auto it = keys.begin(); it != keys.end(); ++it) {
+                for (auto other = it + 1; other != keys.end() and other->first == it->first; ++other) {
+                    if (keys_equal(it->second, other->second)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] Node end_object(usize const first_key) {
+            m_keys.resize(first_key);
+            return Node{};
+        }
+
+        void clear() {
+            m_keys.clear();
+        }
+
+    private:
+        [[nodiscard]] static u16 hex_digit_value(char const c) {
+            if (c >= '0' and c <= '9') {
+                return static_cast<u16>(c - '0');
+            }
+            if (c >= 'a' and c <= 'f') {
+                return static_cast<u16>(c - 'a' + 10);
+            }
+            return static_cast<u16>(c - 'A' + 10);
+        }
+
+        // decodes the next character of a string that has already been checked by the parser
+        [[nodiscard]] static i32 next_codepoint(Utf8StringView::ConstIterator& iterator) {
+            auto const c = *iterator;
+            ++iterator;
+            if (c != '\\') {
+                return c.codepoint();
+            }
+            auto const escaped = (*iterator).as_string_view().front();
+            ++iterator;
+            switch (escaped) {
+                case 'b':
+                    return '\b';
+                case 'f':
+                    return '\f';
+                case 'n':
+                    return '\n';
+                case 'r':
+                    return '\r';
+                case 't':
+                    return '\t';
+                case 'u': {
+                    static constexpr auto read_escape_sequence = [](Utf8StringView::ConstIterator& it) {
+                        auto escape_sequence = u16{};
+                        for (auto i = 0; i < 4; ++i) {
+                            auto const digit = hex_digit_value((*it).as_string_view().front());
+                            escape_sequence = static_cast<u16>(escape_sequence * 16 + digit);
+                            ++it;
+                        }
+                        return escape_sequence;
+                    };
+                    auto const high_surrogate = read_escape_sequence(iterator);
+                    if (high_surrogate < 0xD800 or high_surrogate > 0xDBFF) {
+                        return high_surrogate;
+                    }
+                    ++iterator;  // skip '\\'
+                    ++iterator;  // skip 'u'
+                    auto const low_surrogate = read_escape_sequence(iterator);
+                    return convert_surrogates_to_codepoint(high_surrogate, low_surrogate).value();
+                }
+                default:
+                    return escaped;
+            }
+        }
+
+        [[nodiscard]] static u64 hash_key(Utf8StringView const raw) {
+            // FNV-1a over the decoded codepoints
+            auto hash = u64{ 0xCBF29CE484222325 };
+            for (auto iterator = raw.cbegin(); iterator != raw.cend();) {
+                hash ^= static_cast<u64>(next_codepoint(iterator));
+                hash *= u64{ 0x100000001B3 };
+            }
+            return hash;
+        }
+
+        [[nodiscard]] static bool keys_equal(Utf8StringView const lhs, Utf8StringView const rhs) {
+            if (lhs == rhs) {
+                return true;
+            }
+            auto lhs_iterator = lhs.cbegin();
+            auto rhs_iterator = rhs.cbegin();
+            while (lhs_iterator != lhs.cend() and rhs_iterator != rhs.cend()) {
+                if (next_codepoint(lhs_iterator) != next_codepoint(rhs_iterator)) {
+                    return false;
+                }
+            }
+            return lhs_iterator == lhs.cend() and rhs_iterator == rhs.cend();
+        }
+    };
+
+    // Recursive descent parser for a single JSON value. The `Sink` determines what is built from the input, see
+    // `TreeSink` and `NullSink`.
+    template<typename Sink>
+    class BasicParser final {
+        using Node = typename Sink::Node;
+        using Text = typename Sink::Text;
+
         Utf8StringView m_input;
         Utf8StringView::ConstIterator m_current;
+        Sink m_sink;
+        ParseOptions m_options;
+        usize m_depth = 0;
+        usize m_num_nodes = 0;
+        // approximation of the memory allocated for the resulting tree
+        usize m_num_allocated_bytes = 0;
 
     public:
-        explicit Parser(Utf8StringView const input)
-            : m_input{ input }, m_current{ input.cbegin() } {}
+        BasicParser(Utf8StringView const input, Sink sink, ParseOptions const& options = {})
+            : m_input{ input }, m_current{ input.cbegin() }, m_sink{ std::move(sink) }, m_options{ options } {}
+
+        [[nodiscard]] std::expected<Node, Error> parse() {
+            return clear_state_on_error(element(nullptr));
+        }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> parse() {
-            return element();
+        // parses the input while validating it against `schema`, which fails as soon as a violation is detected
+        [[nodiscard]] std::expected<Node, Error> parse(SchemaNode const& schema)
+            requires Sink::builds_values
+        {
+            return clear_state_on_error(element(&schema));
+        }
+
+        // after a successful parse, this is the end of the root value (including trailing whitespace)
+        [[nodiscard]] Utf8StringView::ConstIterator position() const {
+            return m_current;
+        }
+
+        // parses a comma-separated list of elements spanning the whole input, i.e. the contents of an array
+        // without the surrounding brackets
+        [[nodiscard]] std::expected<Array::Elements, Error> parse_elements()
+            requires Sink::builds_values
+        {
+            return clear_state_on_error([&]() -> std::expected<Array::Elements, Error> {
+                if (auto const result = elements(nullptr); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+                if (not is_at_end_of_input()) {
+                    return parse_error(ParseErrorCode::ExpectedCharacter, ',');
+                }
+                return m_sink.take_elements(0);
+            }());
+        }
+
+        // consumes the opening bracket of a root array, its elements can then be parsed one at a time via
+        // `parse_next_element()`
+        [[nodiscard]] std::expected<std::monostate, Error> begin_array() {
+            consume_whitespace();
+            if (auto const result = consume('['); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
+            consume_whitespace();
+            return std::monostate{};
+        }
+
+        // returns `tl::nullopt` after consuming the closing bracket of the array
+        [[nodiscard]] std::expected<tl::optional<ValuePointer>, Error> parse_next_element(bool const is_first)
+            requires Sink::builds_values
+        {
+            if (current() == ']') {
+                advance();  // consume ']'
+                return tl::nullopt;
+            }
+            if (not is_first) {
+                if (auto const result = consume(','); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+            }
+            auto element_result = clear_state_on_error(element(nullptr));
+            if (not element_result.has_value()) {
+                return std::unexpected{ element_result.error() };
+            }
+            return std::move(element_result).value();
         }
 
     private:
-        [[nodiscard]] std::expected<ValuePointer, Error> element() {
+        // a failed parse leaves its partial results in the state, which is shared with later parses
+        template<typename T>
+        [[nodiscard]] std::expected<T, Error> clear_state_on_error(std::expected<T, Error> result) {
+            if (not result.has_value()) {
+                m_sink.clear();
+            }
+            return result;
+        }
+
+        // `schema` is `nullptr` if the value is not validated
+        [[nodiscard]] std::expected<Node, Error> element(SchemaNode const* const schema) {
+            ++m_num_nodes;
+            if (exceeds(m_options.max_nodes, m_num_nodes)) {
+                return parse_error(ParseErrorCode::TooManyNodes);
+            }
             consume_whitespace();
-            auto result = value();
+            auto const start_iterator = m_current;
+            auto result = value(schema);
+            if (result.has_value()) {
+                m_sink.source(result.value(), Utf8StringView{ start_iterator, m_current });
+            }
             consume_whitespace();
             return result;
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> value() {
+        [[nodiscard]] std::expected<Node, Error> value(SchemaNode const* const schema) {
+            if constexpr (not Sink::builds_values) {
+                // a schema is checked against the values, so without them there's nothing to check
+                return unchecked_value(nullptr);
+            } else {
+                return checked_value(schema);
+            }
+        }
+
+        [[nodiscard]] std::expected<Node, Error> checked_value(SchemaNode const* const schema) {
+            if (schema == nullptr) {
+                return unchecked_value(nullptr);
+            }
+            if (auto const result = schema->check_start(current().as_string_view().front()); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
+            auto result = unchecked_value(schema);
+            if (not result.has_value()) {
+                return result;
+            }
+            if (auto const check_result = schema->check_value(*result.value()); not check_result.has_value()) {
+                return std::unexpected{ check_result.error() };
+            }
+            return result;
+        }
+
+        // the contents of arrays and objects are still checked against `schema`, but not the value itself
+        [[nodiscard]] std::expected<Node, Error> unchecked_value(SchemaNode const* const schema) {
             switch (auto const c = current().as_string_view().front()) {
                 case '{':
-                    return object();
+                    return object(schema);
                 case '[':
-                    return array();
-                case '"':
-                    return string();
+                    return array(schema);
+                case '"': {
+                    auto string_result = string();
+                    if (not string_result.has_value()) {
+                        return std::unexpected{ string_result.error() };
+                    }
+                    if (auto const result = allocate(sizeof(String)); not result.has_value()) {
+                        return std::unexpected{ result.error() };
+                    }
+                    return m_sink.string(std::move(string_result).value());
+                }
                 case 't':
                 case 'f':
                     return boolean();
@@ -64,135 +468,169 @@ namespace c2k::json::detail {
                 default:
                     if (c != '-' and not std::isdigit(static_cast<unsigned char>(c))) {
                         if (is_at_end_of_input()) {
-                            return std::unexpected{ ParseError{ "unexpected end of input" } };
+                            return parse_error(ParseErrorCode::UnexpectedEndOfInput);
                         }
-                        return std::unexpected{ ParseError{
-                            std::format("unexpected character: {}", current().as_string_view()) } };
+                        return parse_error(ParseErrorCode::UnexpectedCharacter);
                     }
                     return number();
             }
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> object() {
+        [[nodiscard]] std::expected<Node, Error> object(SchemaNode const* const schema) {
             if (auto const result = consume('{'); not result.has_value()) {
                 return std::unexpected{ result.error() };
             }
+            if (auto const result = enter_container(); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
             consume_whitespace();
-            auto members = std::vector<std::pair<String, ValuePointer>>{};
+            auto const first_member = m_sink.begin_object();
+            auto num_members = usize{ 0 };
             if (current() != '}') {
-                auto members_result = this->members();
-                if (members_result.has_value()) {
-                    members = std::move(members_result).value();
-                } else {
-                    return std::unexpected{ members_result.error() };
+                auto const result = members(schema);
+                if (not result.has_value()) {
+                    return std::unexpected{ result.error() };
                 }
+                num_members = result.value();
             }
             if (auto const result = consume('}'); not result.has_value()) {
                 return std::unexpected{ result.error() };
             }
-            auto keys = std::unordered_set<Utf8StringView>{};
-            for (auto const& key : members | std::views::keys) {
-                if (auto&& [_, inserted] = keys.insert(key.value.view()); not inserted) {
-                    return std::unexpected{ ParseError{ std::format("Duplicate key: {}", key.value.c_str()) } };
-                }
+            if (m_sink.has_duplicate_keys(first_member)) {
+                // the keys may not refer to the input anymore, so the end of the object is reported instead
+                return parse_error(ParseErrorCode::DuplicateKey);
             }
-            return std::make_unique<Object>(std::move(members));
-        }
-
-        [[nodiscard]] std::expected<std::vector<std::pair<String, ValuePointer>>, Error> members() {
-            auto result = std::vector<std::pair<String, ValuePointer>>{};
-            auto member_result = member();
-            if (not member_result.has_value()) {
-                return std::unexpected{ member_result.error() };
+            // the members have been charged while they were read, the ones that fit into the object itself are given
+            // back since they don't need a separate allocation
+            if (num_members <= Object::inline_capacity) {
+                m_num_allocated_bytes -= num_members * sizeof(Object::Members::value_type);
             }
-            result.emplace_back(std::move(member_result).value());
-            if (current() != ',') {
-                return result;
+            if (auto const result = allocate(sizeof(Object)); not result.has_value()) {
+                return std::unexpected{ result.error() };
             }
-            advance();  // consume ','
-            auto sub_members_result = members();
-            if (not sub_members_result.has_value()) {
-                return std::unexpected{ sub_members_result.error() };
+            --m_depth;
+            return m_sink.end_object(first_member);
+        }
+
+        // returns the number of members
+        [[nodiscard]] std::expected<usize, Error> members(SchemaNode const* const schema) {
+            auto num_members = usize{ 0 };
+            while (true) {
+                ++num_members;
+                if (exceeds(m_options.max_object_members, num_members)) {
+                    return parse_error(ParseErrorCode::TooManyMembers);
+                }
+                if (auto const result = member(schema); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+                if (auto const result = allocate(sizeof(Object::Members::value_type)); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+                if (current() != ',') {
+                    return num_members;
+                }
+                advance();  // consume ','
             }
-            auto sub_members = std::move(sub_members_result).value();
-            std::ranges::move(sub_members, std::back_inserter(result));
-            return result;
         }
 
-        [[nodiscard]] std::expected<std::pair<String, ValuePointer>, Error> member() {
+        [[nodiscard]] std::expected<std::monostate, Error> member(SchemaNode const* const schema) {
             consume_whitespace();
             auto key_result = string();
             if (not key_result.has_value()) {
                 return std::unexpected{ key_result.error() };
             }
-            auto const key = std::move(key_result).value();
-            auto key_string = std::move(dynamic_cast<String&>(*key));
+            auto value_schema = std::expected<SchemaNode const*, Error>{ nullptr };
+            if constexpr (Sink::builds_values) {
+                if (schema != nullptr) {
+                    value_schema = schema->property(key_result.value());
+                    if (not value_schema.has_value()) {
+                        return std::unexpected{ value_schema.error() };
+                    }
+                }
+            }
             consume_whitespace();
             if (current() != ':') {
-                return std::unexpected{ ParseError{ "expected ':'" } };
+                return parse_error(ParseErrorCode::ExpectedCharacter, ':');
             }
             advance();  // consume ':'
-            auto element_result = element();
+            auto element_result = element(value_schema.value());
             if (not element_result.has_value()) {
                 return std::unexpected{ element_result.error() };
             }
-            return std::make_pair(std::move(key_string), std::move(element_result).value());
+            m_sink.member(std::move(key_result).value(), std::move(element_result).value());
+            return std::monostate{};
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> array() {
+        [[nodiscard]] std::expected<Node, Error> array(SchemaNode const* const schema) {
             if (auto const result = consume('['); not result.has_value()) {
                 return std::unexpected{ result.error() };
             }
+            if (auto const result = enter_container(); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
             consume_whitespace();
-            auto elements = std::vector<ValuePointer>{};
+            auto const first_element = m_sink.begin_array();
+            auto num_elements = usize{ 0 };
             if (current() != ']') {
-                auto elements_result = this->elements();
-                if (elements_result.has_value()) {
-                    elements = std::move(elements_result).value();
-                } else {
-                    return std::unexpected{ elements_result.error() };
+                auto const result = elements(schema);
+                if (not result.has_value()) {
+                    return std::unexpected{ result.error() };
                 }
+                num_elements = result.value();
             }
             if (auto const result = consume(']'); not result.has_value()) {
                 return std::unexpected{ result.error() };
             }
-            return std::make_unique<Array>(std::move(elements));
-        }
-
-        [[nodiscard]] std::expected<std::vector<ValuePointer>, Error> elements() {
-            auto result = std::vector<ValuePointer>{};
-            auto element_result = element();
-            if (not element_result.has_value()) {
-                return std::unexpected{ element_result.error() };
+            // see `object()`
+            if (num_elements <= Array::inline_capacity) {
+                m_num_allocated_bytes -= num_elements * sizeof(ValuePointer);
             }
-            result.emplace_back(std::move(element_result).value());
-            if (current() != ',') {
-                return result;
+            if (auto const result = allocate(sizeof(Array)); not result.has_value()) {
+                return std::unexpected{ result.error() };
             }
-            advance();  // consume ','
-            auto sub_elements_result = elements();
-            if (not sub_elements_result.has_value()) {
-                return std::unexpected{ sub_elements_result.error() };
+            --m_depth;
+            return m_sink.end_array(first_element);
+        }
+
+        // returns the number of elements
+        [[nodiscard]] std::expected<usize, Error> elements(SchemaNode const* const schema) {
+            auto const element_schema = schema == nullptr ? nullptr : schema->items.get();
+            auto num_elements = usize{ 0 };
+            while (true) {
+                auto element_result = element(element_schema);
+                if (not element_result.has_value()) {
+                    return std::unexpected{ element_result.error() };
+                }
+                m_sink.element(std::move(element_result).value());
+                if (auto const result = allocate(sizeof(ValuePointer)); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+                ++num_elements;
+                if (schema != nullptr and schema->max_items.has_value() and num_elements > schema->max_items.value()) {
+                    if (auto const result = schema->check_num_items(num_elements); not result.has_value()) {
+                        return std::unexpected{ result.error() };
+                    }
+                }
+                if (current() != ',') {
+                    return num_elements;
+                }
+                advance();  // consume ','
             }
-            auto sub_elements = std::move(sub_elements_result).value();
-            std::ranges::move(sub_elements, std::back_inserter(result));
-            return result;
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> string() {
-            using namespace c2k::Utf8Literals;
+        // returns the decoded string if values are built, its raw contents between the quotes otherwise
+        [[nodiscard]] std::expected<Text, Error> string() {
             if (auto const result = consume('"'); not result.has_value()) {
                 return std::unexpected{ result.error() };
             }
-            if (current() == '"') {
-                advance();  // consume '"'
-                return std::make_unique<String>(""_utf8);
-            }
             static constexpr auto is_character = [](Utf8Char const c) {
                 auto const codepoint = c.codepoint();
                 return codepoint >= 0x20 and codepoint <= 0x10FFFF and codepoint != '"' and codepoint != '\\';
             };
+            auto const start_iterator = m_current;
             auto result = Utf8String{};
+            // length of the result in bytes
+            auto length = usize{ 0 };
             while (not is_at_end_of_input() and current() != '"') {
                 if (current() == '"') {
                     advance();
@@ -203,22 +641,41 @@ namespace c2k::json::detail {
                     if (not escape_sequence_result.has_value()) {
                         return std::unexpected{ escape_sequence_result.error() };
                     }
-                    result += escape_sequence_result.value();
+                    length += escape_sequence_result.value().as_string_view().size();
+                    if (auto const result = check_string_length(length); not result.has_value()) {
+                        return std::unexpected{ result.error() };
+                    }
+                    if constexpr (Sink::builds_values) {
+                        result += escape_sequence_result.value();
+                    }
                     continue;
                 }
                 if (is_character(current())) {
-                    result += current();
+                    length += current().as_string_view().size();
+                    if (auto const result = check_string_length(length); not result.has_value()) {
+                        return std::unexpected{ result.error() };
+                    }
+                    if constexpr (Sink::builds_values) {
+                        result += current();
+                    }
                     advance();
                     continue;
                 }
-                return std::unexpected{ ParseError{
-                    std::format("invalid character in string: {}", current().as_string_view()) } };
+                return parse_error(ParseErrorCode::InvalidCharacterInString);
             }
             if (current() != '"') {
-                return std::unexpected{ ParseError{ "expected '\"'" } };
+                return parse_error(ParseErrorCode::ExpectedCharacter, '"');
             }
+            auto const end_iterator = m_current;
             advance();  // consume '"'
-            return std::make_unique<String>(std::move(result));
+            if (auto const allocation_result = allocate(length); not allocation_result.has_value()) {
+                return std::unexpected{ allocation_result.error() };
+            }
+            if constexpr (Sink::builds_values) {
+                return result;
+            } else {
+                return Utf8StringView{ start_iterator, end_iterator };
+            }
         }
 
         [[nodiscard]] std::expected<Utf8Char, Error> escape_sequence() {
@@ -226,7 +683,7 @@ namespace c2k::json::detail {
                 return std::unexpected{ result.error() };
             }
             if (is_at_end_of_input()) {
-                return std::unexpected{ ParseError{ "unexpected end of input" } };
+                return parse_error(ParseErrorCode::UnexpectedEndOfInput);
             }
             switch (auto const c = current().as_string_view().front()) {
                 case '"':
@@ -268,11 +725,11 @@ namespace c2k::json::detail {
                     }
                     if (escape_sequences.size() == 1) {
                         if (escape_sequences.front() >= 0xD800 and escape_sequences.front() <= 0xDFFF) {
-                            return std::unexpected{ ParseError{ "invalid unicode escape sequence" } };
+                            return parse_error(ParseErrorCode::InvalidUnicodeEscapeSequence);
                         }
                         auto const codepoint_result = Utf8Char::from_codepoint(escape_sequences.front());
                         if (not codepoint_result.has_value()) {
-                            return std::unexpected{ ParseError{ "invalid unicode escape sequence" } };
+                            return parse_error(ParseErrorCode::InvalidUnicodeEscapeSequence);
                         }
                         return codepoint_result.value();
                     }
@@ -281,12 +738,12 @@ namespace c2k::json::detail {
                     auto const low_surrogate = escape_sequences.back();
                     auto const codepoint_result = convert_surrogates_to_codepoint(high_surrogate, low_surrogate);
                     if (not codepoint_result.has_value()) {
-                        return std::unexpected{ codepoint_result.error() };
+                        return parse_error(ParseErrorCode::InvalidSurrogatePair);
                     }
                     return Utf8Char::from_codepoint(codepoint_result.value()).value();
                 }
                 default:
-                    return std::unexpected{ ParseError{ "invalid escape sequence" } };
+                    return parse_error(ParseErrorCode::InvalidEscapeSequence);
             }
         }
 
@@ -303,7 +760,7 @@ namespace c2k::json::detail {
             auto const conversion_result =
                 std::from_chars(hex_string.data(), hex_string.data() + hex_string.size(), escape_sequence, 16);
             if (conversion_result.ec != std::errc{} or conversion_result.ptr != hex_string.data() + hex_string.size()) {
-                return std::unexpected{ ParseError{ "error converting hex constant" } };
+                return parse_error(ParseErrorCode::InvalidHexDigit);
             }
             return escape_sequence;
         }
@@ -322,20 +779,26 @@ namespace c2k::json::detail {
 
             auto const c = current().as_string_view().front();
             if (not is_ascii(c) or not std::isxdigit(static_cast<unsigned char>(c))) {
-                return std::unexpected{ ParseError{ "invalid hex digit" } };
+                return parse_error(ParseErrorCode::InvalidHexDigit);
             }
             advance();
             return c;
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> number() {
+        [[nodiscard]] std::expected<Node, Error> number() {
+            if (auto const result = allocate(sizeof(Number)); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
             auto const start_iterator = m_current;
             auto integer_result = integer();
             if (not integer_result.has_value()) {
                 return std::unexpected{ integer_result.error() };
             }
+            if (exceeds(m_options.max_number_length, Utf8StringView{ start_iterator, m_current }.num_bytes())) {
+                return parse_error(ParseErrorCode::NumberTooLong);
+            }
             if (current() != '.') {
-                return std::make_unique<Number>(static_cast<double>(integer_result.value()));
+                return m_sink.number(static_cast<double>(integer_result.value()));
             }
             advance();  // consume '.'
             auto const fractional_part_start_iterator = m_current;
@@ -344,9 +807,12 @@ namespace c2k::json::detail {
             }
             auto const end_iterator = m_current;
             if (fractional_part_start_iterator == end_iterator) {
-                return std::unexpected{ ParseError{ "expected digit" } };
+                return parse_error(ParseErrorCode::ExpectedDigit);
             }
             auto const number_string_view = Utf8StringView{ start_iterator, end_iterator };
+            if (exceeds(m_options.max_number_length, number_string_view.num_bytes())) {
+                return parse_error(ParseErrorCode::NumberTooLong);
+            }
             auto conversion_buffer = std::string{};
             conversion_buffer.reserve(number_string_view.num_bytes());
             for (auto const c : number_string_view) {
@@ -357,9 +823,9 @@ namespace c2k::json::detail {
                 std::from_chars(conversion_buffer.data(), conversion_buffer.data() + conversion_buffer.size(), result);
             if (conversion_result.ec != std::errc{}
                 or conversion_result.ptr != conversion_buffer.data() + conversion_buffer.size()) {
-                return std::unexpected{ ParseError{ "number out of range" } };
+                return parse_error(ParseErrorCode::NumberOutOfRange);
             }
-            return std::make_unique<Number>(result);
+            return m_sink.number(result);
         }
 
         [[nodiscard]] std::expected<i64, Error> integer(bool const allow_negative = true) {
@@ -370,7 +836,7 @@ namespace c2k::json::detail {
 
             auto const starts_with_minus = current() == '-';
             if (not allow_negative and starts_with_minus) {
-                return std::unexpected{ ParseError{ "unexpected negative integer" } };
+                return parse_error(ParseErrorCode::UnexpectedNegativeInteger);
             }
 
             if (starts_with_minus) {
@@ -394,7 +860,7 @@ namespace c2k::json::detail {
             static constexpr auto max_integer_length = std::numeric_limits<i64>::digits10 + 1;
             // for ASCII digits, the number of bytes is the same as the number of digits
             if (integer_string_view.num_bytes() > max_integer_length) {
-                return std::unexpected{ ParseError{ "integer out of range" } };
+                return parse_error(ParseErrorCode::IntegerOutOfRange);
             }
             auto conversion_buffer = c2k::StaticVector<char, max_integer_length>{};
             for (auto const c : integer_string_view) {
@@ -404,33 +870,39 @@ namespace c2k::json::detail {
             auto const conversion_result =
                 std::from_chars(&*conversion_buffer.cbegin(), &*conversion_buffer.cend(), result);
             if (conversion_result.ec != std::errc{} or conversion_result.ptr != &*conversion_buffer.cend()) {
-                return std::unexpected{ ParseError{ "integer out of range" } };
+                return parse_error(ParseErrorCode::IntegerOutOfRange);
             }
             return result;
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> null() {
+        [[nodiscard]] std::expected<Node, Error> null() {
+            if (auto const result = allocate(sizeof(Null)); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
             static constexpr auto null = std::array{ 'n', 'u', 'l', 'l' };
             if (not try_consume_character_sequence(null)) {
-                return std::unexpected{ ParseError{ "expected 'null'" } };
+                return parse_error(ParseErrorCode::ExpectedNull);
             }
-            return std::make_unique<Null>();
+            return m_sink.null();
         }
 
-        [[nodiscard]] std::expected<ValuePointer, Error> boolean() {
+        [[nodiscard]] std::expected<Node, Error> boolean() {
+            if (auto const result = allocate(sizeof(Boolean)); not result.has_value()) {
+                return std::unexpected{ result.error() };
+            }
             static constexpr auto true_ = std::array{ 't', 'r', 'u', 'e' };
             if (current().as_string_view().front() == 't') {
                 if (try_consume_character_sequence(true_)) {
-                    return std::make_unique<Boolean>(true);
+                    return m_sink.boolean(true);
                 }
-                return std::unexpected{ ParseError{ "expected 'true'" } };
+                return parse_error(ParseErrorCode::ExpectedTrue);
             }
 
             static constexpr auto false_ = std::array{ 'f', 'a', 'l', 's', 'e' };
             if (try_consume_character_sequence(false_)) {
-                return std::make_unique<Boolean>(false);
+                return m_sink.boolean(false);
             }
-            return std::unexpected{ ParseError{ "expected 'false'" } };
+            return parse_error(ParseErrorCode::ExpectedFalse);
         }
 
         template<usize length>
@@ -482,12 +954,53 @@ namespace c2k::json::detail {
             }
         }
 
+        [[nodiscard]] static bool exceeds(tl::optional<usize> const& limit, usize const value) {
+            return limit.has_value() and value > limit.value();
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> enter_container() {
+            ++m_depth;
+            if (exceeds(m_options.max_depth, m_depth)) {
+                return parse_error(ParseErrorCode::MaximumDepthExceeded);
+            }
+            return std::monostate{};
+        }
+
+        // the bytes of a string are only charged once it's complete, but it's rejected as soon as it grows too large
+        [[nodiscard]] std::expected<std::monostate, Error> check_string_length(usize const length) const {
+            if (exceeds(m_options.max_string_length, length)) {
+                return parse_error(ParseErrorCode::StringTooLong);
+            }
+            if (exceeds(m_options.max_memory, m_num_allocated_bytes + length)) {
+                return parse_error(ParseErrorCode::MemoryLimitExceeded);
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> allocate(usize const num_bytes) {
+            m_num_allocated_bytes += num_bytes;
+            if (exceeds(m_options.max_memory, m_num_allocated_bytes)) {
+                return parse_error(ParseErrorCode::MemoryLimitExceeded);
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::unexpected<Error> parse_error(ParseErrorCode const code, char const expected = '\0') const {
+            return std::unexpected<Error>{
+                ParseError{ code, Utf8StringView{ m_input.cbegin(), m_current }.num_bytes(), expected }
+            };
+        }
+
         [[nodiscard]] std::expected<std::monostate, Error> consume(char const c) {
             if (current() != c) {
-                return std::unexpected{ ParseError{ std::format("expected '{}'", c) } };
+                return parse_error(ParseErrorCode::ExpectedCharacter, c);
             }
             advance();
             return std::monostate{};
         }
     };
+
+    using Parser = BasicParser<TreeSink>;
+    // only checks the syntax of the input without building anything
+    using Validator = BasicParser<NullSink>;
 }  // namespace c2k::json::detail
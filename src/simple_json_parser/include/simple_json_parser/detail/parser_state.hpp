@@ -0,0 +1,26 @@
+#pragma once
+
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <utility>
+#include <vector>
+#include "string.hpp"
+#include "value.hpp"
+
+namespace c2k::json::detail {
+    // Scratch buffers of the parser. They are empty after every parse (a failed one clears them) but never
+    // deallocated, so a parser that is reused for many documents stops allocating them once they are large enough.
+    struct ParserState final {
+        // children of all arrays and objects that are currently being parsed, the innermost container's come last
+        std::vector<ValuePointer> elements;
+        std::vector<std::pair<String, ValuePointer>> members;
+        // hashes and views of the keys of the object that is checked for duplicate keys
+        std::vector<std::pair<usize, Utf8StringView>> keys;
+
+        void clear() {
+            elements.clear();
+            members.clear();
+            keys.clear();
+        }
+    };
+}  // namespace c2k::json::detail
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <expected>
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <unordered_map>
+#include "errors.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    // A document from `parse_retaining_source()` together with the text each of its values has been parsed from.
+    // The texts are kept out of the tree itself, so that values don't grow for documents that don't need them.
+    struct RetainedDocument final {
+        ValuePointer root;
+        // The patch functions drop the entries of all values they modify or insert. If the tree is modified in any
+        // other way, the entries of the modified values have to be erased for `reserialize()` to pick up the changes.
+        std::unordered_map<Value const*, Utf8StringView> sources;
+    };
+
+    // Applies a JSON Patch (RFC 6902) to `document`. The operations are applied in place and in order. If one of
+    // them fails, the previous ones stay applied, so `clone()` the document beforehand if it must stay untouched
+    // in that case. Shared subtrees (see `SharedValue`) are copied before they get modified.
+    [[nodiscard]] std::expected<void, Error> apply_patch(ValuePointer& document, Value const& patch);
+
+    // same as above, but also drops the source texts of all values that are modified
+    [[nodiscard]] std::expected<void, Error> apply_patch(RetainedDocument& document, Value const& patch);
+
+    // Applies a JSON Merge Patch (RFC 7396) to `document`. Merge patches cannot fail, every patch is applicable
+    // to every document.
+    void apply_merge_patch(ValuePointer& document, Value const& patch);
+
+    // same as above, but also drops the source texts of all values that are modified
+    void apply_merge_patch(RetainedDocument& document, Value const& patch);
+
+    // Formats the document like `Value::pretty_print()` does, except that the source text of every value that
+    // still has one is copied as is. After patching, only the modified containers are formatted again.
+    [[nodiscard]] Utf8String reserialize(RetainedDocument const& document, usize indentation_step = 2);
+}  // namespace c2k::json
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <expected>
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <memory>
+#include <span>
+#include <tl/optional.hpp>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "errors.hpp"
+#include "string.hpp"
+#include "value.hpp"
+
+namespace c2k::json {
+    namespace detail {
+        enum class SchemaType : u8 {
+            Null = 1 << 0,
+            Boolean = 1 << 1,
+            Integer = 1 << 2,
+            Fraction = 1 << 3,  // a number that is not an integer
+            String = 1 << 4,
+            Array = 1 << 5,
+            Object = 1 << 6,
+        };
+
+        // A single compiled (sub-)schema. Constraints that are not set don't restrict the value.
+        struct SchemaNode final {
+            static constexpr auto all_types = u8{ 0x7F };
+
+            u8 types = all_types;
+            tl::optional<std::vector<ValuePointer>> allowed_values;
+            tl::optional<double> minimum;
+            tl::optional<double> maximum;
+            tl::optional<double> exclusive_minimum;
+            tl::optional<double> exclusive_maximum;
+            tl::optional<usize> min_length;
+            tl::optional<usize> max_length;
+            tl::optional<usize> min_items;
+            tl::optional<usize> max_items;
+            std::vector<std::pair<Utf8String, std::unique_ptr<SchemaNode>>> properties;
+            std::vector<Utf8String> required;
+            std::unique_ptr<SchemaNode> additional_properties;  // any value is allowed if not set
+            std::unique_ptr<SchemaNode> items;                  // any value is allowed if not set
+
+            // checks whether a value starting with `first_character` can have an allowed type, this is done before
+            // the value is parsed to avoid building subtrees that will be rejected anyway
+            [[nodiscard]] std::expected<std::monostate, Error> check_start(char first_character) const;
+
+            // returns the schema of the member called `key`, `nullptr` if any value is allowed
+            [[nodiscard]] std::expected<SchemaNode const*, Error> property(Utf8String const& key) const;
+
+            [[nodiscard]] std::expected<std::monostate, Error> check_num_items(usize num_items) const;
+
+            // checks all remaining constraints of a completely parsed value, nested values have already been checked
+            [[nodiscard]] std::expected<std::monostate, Error> check_value(Value const& value) const;
+
+        private:
+            [[nodiscard]] std::expected<std::monostate, Error> check_number(double value) const;
+            [[nodiscard]] std::expected<std::monostate, Error> check_string(Utf8String const& value) const;
+            [[nodiscard]] std::expected<std::monostate, Error> check_required(
+                std::span<std::pair<String, ValuePointer> const> members
+            ) const;
+        };
+    }  // namespace detail
+
+    // A JSON Schema that has been compiled for use with `parse()`. The following subset of keywords is supported:
+    // `type`, `enum`, `const`, `minimum`, `maximum`, `exclusiveMinimum`, `exclusiveMaximum`, `minLength`,
+    // `maxLength`, `minItems`, `maxItems`, `items` (a single schema), `properties`, `required` and
+    // `additionalProperties`. Boolean schemas are supported as well. The annotations `title`, `description`,
+    // `$schema`, `$id`, `$comment`, `default` and `examples` are ignored, any other keyword is rejected when
+    // compiling. A compiled schema is immutable, so copies of it can be shared between threads.
+    class Schema final {
+        std::shared_ptr<detail::SchemaNode const> m_root;
+
+        explicit Schema(std::shared_ptr<detail::SchemaNode const> root)
+            : m_root{ std::move(root) } {}
+
+    public:
+        [[nodiscard]] static std::expected<Schema, Error> compile(Value const& schema);
+
+        [[nodiscard]] detail::SchemaNode const& root() const {
+            return *m_root;
+        }
+    };
+}  // namespace c2k::json
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <memory>
+#include "value.hpp"
+
+namespace c2k::json {
+    using SharedValuePointer = std::shared_ptr<Value const>;
+
+    // Turns a tree into an immutable one that can be referenced from multiple documents via `SharedValue`.
+    [[nodiscard]] inline SharedValuePointer share(ValuePointer value) {
+        return SharedValuePointer{ std::move(value) };
+    }
+
+    // Refers to an immutable subtree that may be part of multiple documents at the same time. It behaves like the
+    // value it refers to, except that the non-const accessors return `tl::nullopt`. Cloning a `SharedValue` only
+    // copies the reference, to get a mutable copy, use `make_mutable()` or clone `shared()` instead.
+    struct SharedValue final : Value {
+        explicit SharedValue(SharedValuePointer value)
+            : m_value{ std::move(value) } {}
+
+        [[nodiscard]] SharedValuePointer const& shared() const {
+            return m_value;
+        }
+
+        [[nodiscard]] bool is_shared() const override {
+            return true;
+        }
+
+        [[nodiscard]] bool is_object() const override {
+            return m_value->is_object();
+        }
+
+        [[nodiscard]] bool is_array() const override {
+            return m_value->is_array();
+        }
+
+        [[nodiscard]] bool is_string() const override {
+            return m_value->is_string();
+        }
+
+        [[nodiscard]] bool is_number() const override {
+            return m_value->is_number();
+        }
+
+        [[nodiscard]] bool is_boolean() const override {
+            return m_value->is_boolean();
+        }
+
+        [[nodiscard]] bool is_null() const override {
+            return m_value->is_null();
+        }
+
+        [[nodiscard]] tl::optional<Object const&> as_object() const override {
+            return m_value->as_object();
+        }
+
+        [[nodiscard]] tl::optional<Object&> as_object() override {
+            return tl::nullopt;
+        }
+
+        [[nodiscard]] tl::optional<Array const&> as_array() const override {
+            return m_value->as_array();
+        }
+
+        [[nodiscard]] tl::optional<Array&> as_array() override {
+            return tl::nullopt;
+        }
+
+        [[nodiscard]] tl::optional<String const&> as_string() const override {
+            return m_value->as_string();
+        }
+
+        [[nodiscard]] tl::optional<String&> as_string() override {
+            return tl::nullopt;
+        }
+
+        [[nodiscard]] tl::optional<Number const&> as_number() const override {
+            return m_value->as_number();
+        }
+
+        [[nodiscard]] tl::optional<Number&> as_number() override {
+            return tl::nullopt;
+        }
+
+        [[nodiscard]] tl::optional<Boolean const&> as_boolean() const override {
+            return m_value->as_boolean();
+        }
+
+        [[nodiscard]] tl::optional<Boolean&> as_boolean() override {
+            return tl::nullopt;
+        }
+
+        [[nodiscard]] Utf8String format(usize const indentation_step, usize const base_indentation) const override {
+            return m_value->format(indentation_step, base_indentation);
+        }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            return std::make_unique<SharedValue>(m_value);
+        }
+
+    private:
+        SharedValuePointer m_value;
+    };
+
+    // Replaces a shared subtree with a copy of it, so that the non-const accessors of `value` can be used
+    // afterwards. Only the top level is copied, nested shared subtrees stay shared. Values that aren't shared are
+    // left untouched.
+    inline Value& make_mutable(ValuePointer& value) {
+        while (value->is_shared()) {
+            value = static_cast<SharedValue const&>(*value).shared()->clone();
+        }
+        return *value;
+    }
+}  // namespace c2k::json
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <lib2k/types.hpp>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace c2k::json::detail {
+    // A vector that stores up to `inline_capacity` elements within itself and only allocates when it grows beyond
+    // that. Its interface is the subset of `std::vector`'s that is used for the children of arrays and objects.
+    template<typename T, usize inline_capacity>
+    class SmallVector final {
+        static_assert(inline_capacity > 0);
+
+    public:
+        using value_type = T;
+        using size_type = usize;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using iterator = T*;
+        using const_iterator = T const*;
+
+    private:
+        alignas(T) std::byte m_inline_storage[sizeof(T) * inline_capacity];
+        T* m_data = inline_data();
+        usize m_size = 0;
+        usize m_capacity = inline_capacity;
+
+    public:
+        SmallVector() = default;
+
+        // takes over the elements of `elements`
+        explicit SmallVector(std::vector<T>&& elements) {
+            reserve(elements.size());
+            for (auto& element : elements) {
+                emplace_back(std::move(element));
+            }
+        }
+
+        SmallVector(SmallVector const& other)
+            requires std::copy_constructible<T>
+        {
+            reserve(other.size());
+            for (auto const& element : other) {
+                emplace_back(element);
+            }
+        }
+
+        SmallVector(SmallVector&& other) noexcept {
+            take_from(other);
+        }
+
+        SmallVector& operator=(SmallVector const& other)
+            requires std::copy_constructible<T>
+        {
+            if (this != &other) {
+                auto copy = other;
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept {
+            if (this != &other) {
+                release();
+                take_from(other);
+            }
+            return *this;
+        }
+
+        ~SmallVector() {
+            release();
+        }
+
+        [[nodiscard]] usize size() const {
+            return m_size;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] usize capacity() const {
+            return m_capacity;
+        }
+
+        [[nodiscard]] T* data() {
+            return m_data;
+        }
+
+        [[nodiscard]] T const* data() const {
+            return m_data;
+        }
+
+        [[nodiscard]] iterator begin() {
+            return m_data;
+        }
+
+        [[nodiscard]] const_iterator begin() const {
+            return m_data;
+        }
+
+        [[nodiscard]] const_iterator cbegin() const {
+            return m_data;
+        }
+
+        [[nodiscard]] iterator end() {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] const_iterator end() const {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] const_iterator cend() const {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] T& operator[](usize const index) {
+            return m_data[index];
+        }
+
+        [[nodiscard]] T const& operator[](usize const index) const {
+            return m_data[index];
+        }
+
+        [[nodiscard]] T& at(usize const index) {
+            check_index(index);
+            return m_data[index];
+        }
+
+        [[nodiscard]] T const& at(usize const index) const {
+            check_index(index);
+            return m_data[index];
+        }
+
+        [[nodiscard]] T& front() {
+            return m_data[0];
+        }
+
+        [[nodiscard]] T const& front() const {
+            return m_data[0];
+        }
+
+        [[nodiscard]] T& back() {
+            return m_data[m_size - 1];
+        }
+
+        [[nodiscard]] T const& back() const {
+            return m_data[m_size - 1];
+        }
+
+        void reserve(usize const capacity) {
+            if (capacity <= m_capacity) {
+                return;
+            }
+            auto const new_data = static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{ alignof(T) }));
+            std::uninitialized_move(begin(), end(), new_data);
+            std::destroy(begin(), end());
+            deallocate();
+            m_data = new_data;
+            m_capacity = capacity;
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (m_size == m_capacity) {
+                grow();
+            }
+            auto const element = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+            return *element;
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_back(T const& value)
+            requires std::copy_constructible<T>
+        {
+            emplace_back(value);
+        }
+
+        void pop_back() {
+            --m_size;
+            std::destroy_at(m_data + m_size);
+        }
+
+        iterator insert(const_iterator const position, T&& value) {
+            auto const index = static_cast<usize>(position - cbegin());
+            emplace_back(std::move(value));
+            std::rotate(begin() + static_cast<difference_type>(index), end() - 1, end());
+            return begin() + static_cast<difference_type>(index);
+        }
+
+        iterator erase(const_iterator const position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(const_iterator const first, const_iterator const last) {
+            auto const first_index = first - cbegin();
+            auto const last_index = last - cbegin();
+            auto const new_end = std::move(begin() + last_index, end(), begin() + first_index);
+            std::destroy(new_end, end());
+            m_size = static_cast<usize>(new_end - begin());
+            return begin() + first_index;
+        }
+
+        void clear() {
+            std::destroy(begin(), end());
+            m_size = 0;
+        }
+
+    private:
+        [[nodiscard]] T* inline_data() {
+            return reinterpret_cast<T*>(m_inline_storage);
+        }
+
+        [[nodiscard]] bool is_inline() const {
+            return m_capacity == inline_capacity;
+        }
+
+        void check_index(usize const index) const {
+            if (index >= m_size) {
+                throw std::out_of_range{ "index out of range" };
+            }
+        }
+
+        void grow() {
+            reserve(m_capacity * 2);
+        }
+
+        void deallocate() {
+            if (not is_inline()) {
+                ::operator delete(m_data, std::align_val_t{ alignof(T) });
+            }
+        }
+
+        void release() {
+            clear();
+            deallocate();
+            m_data = inline_data();
+            m_capacity = inline_capacity;
+        }
+
+        // expects this vector to be empty and to use its inline storage
+        void take_from(SmallVector& other) {
+            if (other.is_inline()) {
+                std::uninitialized_move(other.begin(), other.end(), inline_data());
+                m_size = other.m_size;
+                other.clear();
+                return;
+            }
+            m_data = std::exchange(other.m_data, other.inline_data());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, inline_capacity);
+        }
+    };
+}  // namespace c2k::json::detail
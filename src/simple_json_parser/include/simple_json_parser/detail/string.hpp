@@ -4,31 +4,13 @@
 #include "value.hpp"
 
 namespace c2k::json {
-    struct String final : Value {
-        Utf8String value;
-
-        String() = default;
-
-        String(Utf8String value)
-            : value{ std::move(value) } {}
-
-        [[nodiscard]] bool is_string() const override {
-            return true;
-        }
-
-        [[nodiscard]] tl::optional<String const&> as_string() const override {
-            return *this;
-        }
-
-        [[nodiscard]] tl::optional<String&> as_string() override {
-            return *this;
-        }
-
-        [[nodiscard]] Utf8String format(usize, usize) const override {
-            using namespace c2k::Utf8Literals;
-            auto result = Utf8String{};
+    namespace detail {
+        // appends `string` as a quoted JSON string, control characters without a short escape sequence are
+        // escaped as `\u00XX`
+        inline void append_escaped(Utf8String const& string, Utf8String& result) {
+            static constexpr auto hex_digits = "0123456789ABCDEF";
             result += '"';
-            for (auto const c : value) {
+            for (auto const c : string) {
                 if (c == '"') {
                     result += "\\\"";
                 } else if (c == '\\') {
@@ -45,12 +27,46 @@ namespace c2k::json {
                     result += "\\r";
                 } else if (c == '\t') {
                     result += "\\t";
+                } else if (auto const codepoint = c.codepoint(); codepoint < 0x20) {
+                    result += "\\u00";
+                    result += hex_digits[codepoint >> 4];
+                    result += hex_digits[codepoint & 0xF];
                 } else {
                     result += c;
                 }
             }
             result += '"';
+        }
+    }  // namespace detail
+
+    struct String final : Value {
+        Utf8String value;
+
+        String() = default;
+
+        String(Utf8String value)
+            : value{ std::move(value) } {}
+
+        [[nodiscard]] bool is_string() const override {
+            return true;
+        }
+
+        [[nodiscard]] tl::optional<String const&> as_string() const override {
+            return *this;
+        }
+
+        [[nodiscard]] tl::optional<String&> as_string() override {
+            return *this;
+        }
+
+        [[nodiscard]] Utf8String format(usize, usize) const override {
+            auto result = Utf8String{};
+            detail::append_escaped(value, result);
             return result;
         }
+
+        [[nodiscard]] ValuePointer clone() const override {
+            return std::make_unique<String>(value);
+        }
     };
 }  // namespace c2k::json
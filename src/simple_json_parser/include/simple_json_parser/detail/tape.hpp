@@ -0,0 +1,350 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <lib2k/types.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <span>
+#include <string_view>
+#include <tl/optional.hpp>
+#include <utility>
+#include <vector>
+#include "errors.hpp"
+#include "value.hpp"
+
+// A tape is a flat, position-independent image of a document that can be stored on disk and later be accessed
+// directly (e.g. after memory-mapping the file) without parsing it again. It consists of a header, the tape
+// itself (one or two little-endian 64-bit words per value) and a section containing the bytes of all strings.
+// Arrays and objects store the index of the word right after their last child, so that they can be skipped.
+
+namespace c2k::json {
+    struct TapeArray;
+    struct TapeObject;
+
+    namespace detail {
+        enum class TapeType : u8 {
+            Null,
+            True,
+            False,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+        struct TapeView final {
+            std::byte const* words;
+            usize num_words;
+            char const* strings;
+            usize num_string_bytes;
+
+            [[nodiscard]] u64 word(usize const index) const {
+                auto result = u64{};
+                std::memcpy(&result, words + index * sizeof(u64), sizeof(u64));
+                if constexpr (std::endian::native == std::endian::big) {
+                    result = std::byteswap(result);
+                }
+                return result;
+            }
+
+            [[nodiscard]] TapeType type(usize const index) const {
+                return static_cast<TapeType>(word(index) >> 56);
+            }
+
+            [[nodiscard]] u64 payload(usize const index) const {
+                return word(index) & ((u64{ 1 } << 56) - 1);
+            }
+
+            // index of the next value after the one at `index`
+            [[nodiscard]] usize skip(usize const index) const {
+                switch (type(index)) {
+                    case TapeType::Number:
+                    case TapeType::String:
+                        return index + 2;
+                    case TapeType::Array:
+                    case TapeType::Object:
+                        return payload(index);
+                    default:
+                        return index + 1;
+                }
+            }
+
+            [[nodiscard]] std::string_view string(usize const index) const {
+                return std::string_view{ strings + payload(index), word(index + 1) };
+            }
+        };
+    }  // namespace detail
+
+    // the counterparts of `String`, `Number` and `Boolean` for values on a tape
+    struct TapeString final {
+        std::string_view value;
+    };
+
+    struct TapeNumber final {
+        double value;
+    };
+
+    struct TapeBoolean final {
+        bool value;
+    };
+
+    // Refers to a value on a tape and offers the same accessors as `Value`. `operator->` allows to use a
+    // `TapeValue` in the same way as a `ValuePointer`.
+    class TapeValue final {
+        detail::TapeView m_tape;
+        usize m_index;
+
+    public:
+        TapeValue(detail::TapeView const tape, usize const index)
+            : m_tape{ tape }, m_index{ index } {}
+
+        [[nodiscard]] TapeValue const* operator->() const {
+            return this;
+        }
+
+        [[nodiscard]] bool is_object() const {
+            return m_tape.type(m_index) == detail::TapeType::Object;
+        }
+
+        [[nodiscard]] bool is_array() const {
+            return m_tape.type(m_index) == detail::TapeType::Array;
+        }
+
+        [[nodiscard]] bool is_string() const {
+            return m_tape.type(m_index) == detail::TapeType::String;
+        }
+
+        [[nodiscard]] bool is_number() const {
+            return m_tape.type(m_index) == detail::TapeType::Number;
+        }
+
+        [[nodiscard]] bool is_boolean() const {
+            auto const type = m_tape.type(m_index);
+            return type == detail::TapeType::True or type == detail::TapeType::False;
+        }
+
+        [[nodiscard]] bool is_null() const {
+            return m_tape.type(m_index) == detail::TapeType::Null;
+        }
+
+        [[nodiscard]] tl::optional<TapeObject> as_object() const;
+
+        [[nodiscard]] tl::optional<TapeArray> as_array() const;
+
+        [[nodiscard]] tl::optional<TapeString> as_string() const {
+            if (not is_string()) {
+                return tl::nullopt;
+            }
+            return TapeString{ m_tape.string(m_index) };
+        }
+
+        [[nodiscard]] tl::optional<TapeNumber> as_number() const {
+            if (not is_number()) {
+                return tl::nullopt;
+            }
+            return TapeNumber{ std::bit_cast<double>(m_tape.word(m_index + 1)) };
+        }
+
+        [[nodiscard]] tl::optional<TapeBoolean> as_boolean() const {
+            if (not is_boolean()) {
+                return tl::nullopt;
+            }
+            return TapeBoolean{ m_tape.type(m_index) == detail::TapeType::True };
+        }
+
+        // copies this value (and all its children) into a regular tree
+        [[nodiscard]] ValuePointer to_value() const;
+
+        [[nodiscard]] Utf8String pretty_print(usize const indentation_step = 2) const {
+            return to_value()->pretty_print(indentation_step);
+        }
+    };
+
+    // Forward range over the values of an array on a tape. In contrast to `Array::elements`, accessing an element
+    // by index has to skip all elements before it.
+    class TapeElements final {
+        detail::TapeView m_tape;
+        usize m_index;
+
+    public:
+        class Iterator final {
+            detail::TapeView m_tape;
+            usize m_index;
+
+        public:
+            using value_type = TapeValue;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator()
+                : m_tape{}, m_index{ 0 } {}
+
+            Iterator(detail::TapeView const tape, usize const index)
+                : m_tape{ tape }, m_index{ index } {}
+
+            [[nodiscard]] TapeValue operator*() const {
+                return TapeValue{ m_tape, m_index };
+            }
+
+            Iterator& operator++() {
+                m_index = m_tape.skip(m_index);
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto const result = *this;
+                ++*this;
+                return result;
+            }
+
+            [[nodiscard]] bool operator==(Iterator const& other) const {
+                return m_index == other.m_index;
+            }
+        };
+
+        TapeElements(detail::TapeView const tape, usize const index)
+            : m_tape{ tape }, m_index{ index } {}
+
+        [[nodiscard]] usize size() const {
+            return m_tape.word(m_index + 1);
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]] Iterator begin() const {
+            return Iterator{ m_tape, m_index + 2 };
+        }
+
+        [[nodiscard]] Iterator end() const {
+            return Iterator{ m_tape, m_tape.payload(m_index) };
+        }
+
+        [[nodiscard]] TapeValue operator[](usize const index) const {
+            auto element = begin();
+            for (auto i = usize{ 0 }; i < index; ++i) {
+                ++element;
+            }
+            return *element;
+        }
+    };
+
+    // Forward range over the members of an object on a tape, yielding pairs of `TapeString` and `TapeValue`.
+    class TapeMembers final {
+        detail::TapeView m_tape;
+        usize m_index;
+
+    public:
+        class Iterator final {
+            detail::TapeView m_tape;
+            usize m_index;
+
+        public:
+            using value_type = std::pair<TapeString, TapeValue>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator()
+                : m_tape{}, m_index{ 0 } {}
+
+            Iterator(detail::TapeView const tape, usize const index)
+                : m_tape{ tape }, m_index{ index } {}
+
+            [[nodiscard]] value_type operator*() const {
+                // every key is a string which takes up two words
+                return value_type{ TapeString{ m_tape.string(m_index) }, TapeValue{ m_tape, m_index + 2 } };
+            }
+
+            Iterator& operator++() {
+                m_index = m_tape.skip(m_index + 2);
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto const result = *this;
+                ++*this;
+                return result;
+            }
+
+            [[nodiscard]] bool operator==(Iterator const& other) const {
+                return m_index == other.m_index;
+            }
+        };
+
+        TapeMembers(detail::TapeView const tape, usize const index)
+            : m_tape{ tape }, m_index{ index } {}
+
+        [[nodiscard]] usize size() const {
+            return m_tape.word(m_index + 1);
+        }
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]] Iterator begin() const {
+            return Iterator{ m_tape, m_index + 2 };
+        }
+
+        [[nodiscard]] Iterator end() const {
+            return Iterator{ m_tape, m_tape.payload(m_index) };
+        }
+
+        [[nodiscard]] tl::optional<TapeValue> find(std::string_view const key) const {
+            for (auto const& [member_key, member_value] : *this) {
+                if (member_key.value == key) {
+                    return member_value;
+                }
+            }
+            return tl::nullopt;
+        }
+    };
+
+    // the counterparts of `Array` and `Object`
+    struct TapeArray final {
+        TapeElements elements;
+    };
+
+    struct TapeObject final {
+        TapeMembers values;
+    };
+
+    [[nodiscard]] inline tl::optional<TapeObject> TapeValue::as_object() const {
+        if (not is_object()) {
+            return tl::nullopt;
+        }
+        return TapeObject{ TapeMembers{ m_tape, m_index } };
+    }
+
+    [[nodiscard]] inline tl::optional<TapeArray> TapeValue::as_array() const {
+        if (not is_array()) {
+            return tl::nullopt;
+        }
+        return TapeArray{ TapeElements{ m_tape, m_index } };
+    }
+
+    // A tape that refers to externally owned memory, e.g. a memory-mapped file. The memory has to outlive the
+    // `TapeDocument` and all values obtained from it.
+    class TapeDocument final {
+        detail::TapeView m_tape;
+
+        explicit TapeDocument(detail::TapeView const tape)
+            : m_tape{ tape } {}
+
+    public:
+        // Only checks the header, so that opening a tape doesn't have to touch all of its memory. Tapes from
+        // untrusted sources have to be checked with `verify()` before accessing any values.
+        [[nodiscard]] static std::expected<TapeDocument, Error> open(std::span<std::byte const> data);
+
+        // checks the structure of the whole tape, i.e. that all values can be accessed without reading out of bounds
+        [[nodiscard]] std::expected<void, Error> verify() const;
+
+        [[nodiscard]] TapeValue root() const {
+            return TapeValue{ m_tape, 0 };
+        }
+    };
+
+    // creates a tape of `value` that can be stored and later be opened via `TapeDocument::open()`
+    [[nodiscard]] std::vector<std::byte> to_tape(Value const& value);
+}  // namespace c2k::json
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <lib2k/types.hpp>
+#include <string_view>
+
+namespace c2k::json::detail {
+    // checks whether `bytes` is well-formed UTF-8 (no overlong encodings, surrogates or codepoints beyond U+10FFFF)
+    [[nodiscard]] inline bool is_valid_utf8(std::string_view const bytes) {
+        auto i = usize{ 0 };
+        while (i < bytes.size()) {
+            auto const lead = static_cast<unsigned char>(bytes[i]);
+            if (lead < 0x80) {
+                ++i;
+                continue;
+            }
+            auto length = usize{};
+            auto codepoint = u32{};
+            if ((lead & 0xE0) == 0xC0) {
+                length = 2;
+                codepoint = lead & 0x1Fu;
+            } else if ((lead & 0xF0) == 0xE0) {
+                length = 3;
+                codepoint = lead & 0x0Fu;
+            } else if ((lead & 0xF8) == 0xF0) {
+                length = 4;
+                codepoint = lead & 0x07u;
+            } else {
+                return false;
+            }
+            if (i + length > bytes.size()) {
+                return false;
+            }
+            for (auto j = usize{ 1 }; j < length; ++j) {
+                auto const continuation = static_cast<unsigned char>(bytes[i + j]);
+                if ((continuation & 0xC0) != 0x80) {
+                    return false;
+                }
+                codepoint = (codepoint << 6) | (continuation & 0x3Fu);
+            }
+            static constexpr auto min_codepoints = std::array<u32, 5>{ 0, 0, 0x80, 0x800, 0x10000 };
+            if (codepoint < min_codepoints.at(length) or codepoint > 0x10FFFF
+                or (codepoint >= 0xD800 and codepoint <= 0xDFFF)) {
+                return false;
+            }
+            i += length;
+        }
+        return true;
+    }
+}  // namespace c2k::json::detail
@@ -13,14 +13,23 @@ namespace c2k::json {
     struct Object;
     struct String;
 
+    struct Value;
+
+    using ValuePointer = std::unique_ptr<Value>;
+
     struct Value {
         Value() = default;
+        virtual ~Value() = default;
+
+    protected:
+        // copying is only possible for the concrete (non-container) types to prevent slicing, use `clone()` to
+        // copy arbitrary values
         Value(Value const& other) = default;
         Value(Value&& other) noexcept = default;
         Value& operator=(Value const& other) = default;
         Value& operator=(Value&& other) noexcept = default;
-        virtual ~Value() = default;
 
+    public:
         [[nodiscard]] virtual bool is_object() const {
             return false;
         }
@@ -45,6 +54,14 @@ namespace c2k::json {
             return false;
         }
 
+        // true for values that refer to a shared subtree (see `SharedValue`), those report their type through
+        // `is_*()` and the const `as_*()` accessors, but their non-const `as_*()` accessors return `tl::nullopt`
+        [[nodiscard]] virtual bool is_shared() const {
+            return false;
+        }
+
+        // the non-const accessors return `tl::nullopt` for shared subtrees even if the corresponding `is_*()` check
+        // succeeds, use `make_mutable()` to get a modifiable copy first
         [[nodiscard]] virtual tl::optional<Object const&> as_object() const {
             return tl::nullopt;
         }
@@ -91,6 +108,9 @@ namespace c2k::json {
 
         [[nodiscard]] virtual Utf8String format(usize indentation_step, usize base_indentation) const = 0;
 
+        // creates a deep copy of this value
+        [[nodiscard]] virtual ValuePointer clone() const = 0;
+
     protected:
         static void insert_indent(Utf8String& string, usize const amount) {
             using namespace c2k::Utf8Literals;
@@ -99,6 +119,4 @@ namespace c2k::json {
             }
         }
     };
-
-    using ValuePointer = std::unique_ptr<Value>;
 }  // namespace c2k::json
@@ -4,12 +4,23 @@
 #include <filesystem>
 #include <lib2k/utf8/string_view.hpp>
 #include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/array_stream.hpp>
+#include <simple_json_parser/detail/async_parser.hpp>
 #include <simple_json_parser/detail/boolean.hpp>
+#include <simple_json_parser/detail/cbor.hpp>
+#include <simple_json_parser/detail/comparison.hpp>
+#include <simple_json_parser/detail/document_parser.hpp>
 #include <simple_json_parser/detail/errors.hpp>
+#include <simple_json_parser/detail/formatter.hpp>
 #include <simple_json_parser/detail/null.hpp>
 #include <simple_json_parser/detail/number.hpp>
 #include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/options.hpp>
+#include <simple_json_parser/detail/patch.hpp>
+#include <simple_json_parser/detail/schema.hpp>
+#include <simple_json_parser/detail/shared_value.hpp>
 #include <simple_json_parser/detail/string.hpp>
+#include <simple_json_parser/detail/tape.hpp>
 #include <simple_json_parser/detail/value.hpp>
 
 namespace c2k::json {
@@ -17,4 +28,26 @@ namespace c2k::json {
         Utf8StringView input,
         tl::optional<std::filesystem::path const&> path = tl::nullopt
     );
+
+    // Same as `parse()`, but fails with a `ParseError` as soon as `input` exceeds one of the limits in `options`.
+    [[nodiscard]] std::expected<ValuePointer, Error> parse(Utf8StringView input, ParseOptions const& options);
+
+    // Same as `parse()`, but the document is validated against `schema` while it's being parsed. Parsing stops
+    // at the first violation, which is reported as a `ValidationError`.
+    [[nodiscard]] std::expected<ValuePointer, Error> parse(Utf8StringView input, Schema const& schema);
+
+    // Same as `parse()`, but also records the text every value has been parsed from (see `RetainedDocument`), which
+    // allows `reserialize()` to copy unmodified parts of the document instead of formatting them again. The
+    // recorded texts refer to `input`, so it has to outlive all calls to `reserialize()`.
+    [[nodiscard]] std::expected<RetainedDocument, Error> parse_retaining_source(Utf8StringView input);
+
+    // Same as `parse()`, but if the root of `input` is an array, its elements are split into chunks that get
+    // parsed concurrently. Inputs that are too small to be split are parsed on the calling thread.
+    [[nodiscard]] std::expected<ValuePointer, Error> parse_parallel(
+        Utf8StringView input,
+        ParallelParseOptions const& options = {}
+    );
+
+    // checks whether `input` would be accepted by `parse()` without building the `Value` tree
+    [[nodiscard]] std::expected<void, Error> validate(Utf8StringView input, ValidateOptions const& options = {});
 }
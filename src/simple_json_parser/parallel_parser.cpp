@@ -0,0 +1,138 @@
+#include <simple_json_parser/detail/parser.hpp>
+#include <simple_json_parser/simple_json_parser.hpp>
+#include <thread>
+
+namespace c2k::json {
+    namespace {
+        // Scans the array starting at `array_start` for commas that separate its top-level elements and picks
+        // some of them so that the chunks between them are at least `min_chunk_size` bytes long. This only
+        // tracks strings and nesting, the chunks are validated when they get parsed.
+        // The first split point points right behind the opening '[', the last one points to the closing ']' and all
+        // others point to a top-level ','.
+        [[nodiscard]] tl::optional<std::vector<Utf8StringView::ConstIterator>> find_split_points(
+            Utf8StringView const input,
+            Utf8StringView::ConstIterator const array_start,
+            usize const min_chunk_size
+        ) {
+            auto split_points = std::vector{ array_start + 1 };
+            auto depth = usize{ 0 };
+            auto is_in_string = false;
+            auto is_escaped = false;
+            auto chunk_size = usize{ 0 };
+            for (auto iterator = array_start + 1; iterator != input.cend(); ++iterator) {
+                auto const character = *iterator;
+                auto const c = character.as_string_view();
+                chunk_size += c.size();
+                if (is_in_string) {
+                    if (is_escaped) {
+                        is_escaped = false;
+                    } else if (c.front() == '\\') {
+                        is_escaped = true;
+                    } else if (c.front() == '"') {
+                        is_in_string = false;
+                    }
+                    continue;
+                }
+                switch (c.front()) {
+                    case '"':
+                        is_in_string = true;
+                        break;
+                    case '[':
+                    case '{':
+                        ++depth;
+                        break;
+                    case ']':
+                        if (depth == 0) {
+                            split_points.push_back(iterator);
+                            return split_points;
+                        }
+                        --depth;
+                        break;
+                    case '}':
+                        if (depth == 0) {
+                            return tl::nullopt;
+                        }
+                        --depth;
+                        break;
+                    case ',':
+                        if (depth == 0 and chunk_size >= min_chunk_size) {
+                            split_points.push_back(iterator);
+                            chunk_size = 0;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+            }
+            return tl::nullopt;
+        }
+    }  // namespace
+
+    [[nodiscard]] std::expected<ValuePointer, Error> parse_parallel(
+        Utf8StringView const input,
+        ParallelParseOptions const& options
+    ) {
+        auto const parse_sequentially = [&] {
+            auto state = detail::ParserState{};
+            auto parser = detail::Parser{ input, state };
+            return parser.parse();
+        };
+
+        auto const num_threads = std::max(
+            usize{ 1 },
+            options.num_threads == 0 ? usize{ std::thread::hardware_concurrency() } : options.num_threads
+        );
+        static constexpr auto is_whitespace = [](Utf8Char const c) {
+            return c == 0x20 or c == 0x0A or c == 0x0D or c == 0x09;
+        };
+        auto array_start = input.cbegin();
+        while (array_start != input.cend() and is_whitespace(*array_start)) {
+            ++array_start;
+        }
+        if (num_threads == 1 or array_start == input.cend() or *array_start != '[') {
+            return parse_sequentially();
+        }
+
+        auto const min_chunk_size = std::max(options.min_chunk_size, input.num_bytes() / num_threads);
+        auto const split_result = find_split_points(input, array_start, min_chunk_size);
+        if (not split_result.has_value() or split_result->size() <= 2) {
+            // either there's only one chunk or the input is malformed, in which case the regular parser will
+            // report the error
+            return parse_sequentially();
+        }
+
+        auto const& split_points = split_result.value();
+        auto const num_chunks = split_points.size() - 1;
+        auto results = std::vector<std::expected<Array::Elements, Error>>(num_chunks);
+        auto const parse_chunk = [&](usize const chunk) {
+            auto const begin = chunk == 0 ? split_points.at(chunk) : split_points.at(chunk) + 1;  // skip ','
+            auto state = detail::ParserState{};
+            auto parser = detail::Parser{ Utf8StringView{ begin, split_points.at(chunk + 1) }, state };
+            results.at(chunk) = parser.parse_elements();
+        };
+        {
+            auto threads = std::vector<std::jthread>{};
+            threads.reserve(num_chunks - 1);
+            for (auto chunk = usize{ 1 }; chunk < num_chunks; ++chunk) {
+                threads.emplace_back(parse_chunk, chunk);
+            }
+            parse_chunk(0);
+        }
+
+        auto num_elements = usize{ 0 };
+        for (auto const& result : results) {
+            if (not result.has_value()) {
+                // re-parse to report the same error as `parse()` would, without holding on to the other chunks
+                results.clear();
+                return parse_sequentially();
+            }
+            num_elements += result->size();
+        }
+        auto elements = Array::Elements{};
+        elements.reserve(num_elements);
+        for (auto& result : results) {
+            std::ranges::move(result.value(), std::back_inserter(elements));
+        }
+        return std::make_unique<Array>(std::move(elements));
+    }
+}  // namespace c2k::json
@@ -0,0 +1,505 @@
+#include <charconv>
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/comparison.hpp>
+#include <simple_json_parser/detail/null.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/patch.hpp>
+#include <simple_json_parser/detail/shared_value.hpp>
+#include <simple_json_parser/detail/string.hpp>
+#include <ranges>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace c2k::json {
+    namespace {
+        using Tokens = std::span<Utf8String const>;
+        // source texts of a `RetainedDocument`, `nullptr` if the document doesn't have any
+        using Sources = std::unordered_map<Value const*, Utf8StringView>*;
+
+        [[nodiscard]] std::unexpected<Error> patch_error(std::string message) {
+            return std::unexpected<Error>{ PatchError{ std::move(message) } };
+        }
+
+        // splits a JSON Pointer (RFC 6901) into its unescaped reference tokens
+        [[nodiscard]] std::expected<std::vector<Utf8String>, Error> parse_pointer(Utf8String const& pointer) {
+            auto tokens = std::vector<Utf8String>{};
+            auto is_escaped = false;
+            for (auto const c : pointer) {
+                if (tokens.empty()) {
+                    if (c != '/') {
+                        return patch_error("a JSON pointer must start with '/'");
+                    }
+                    tokens.emplace_back();
+                } else if (is_escaped) {
+                    if (c == '0') {
+                        tokens.back() += Utf8Char{ '~' };
+                    } else if (c == '1') {
+                        tokens.back() += Utf8Char{ '/' };
+                    } else {
+                        return patch_error("invalid escape sequence in JSON pointer");
+                    }
+                    is_escaped = false;
+                } else if (c == '~') {
+                    is_escaped = true;
+                } else if (c == '/') {
+                    tokens.emplace_back();
+                } else {
+                    tokens.back() += c;
+                }
+            }
+            if (is_escaped) {
+                return patch_error("invalid escape sequence in JSON pointer");
+            }
+            return tokens;
+        }
+
+        // converts an array index token, `max_index` is the largest index that is allowed
+        [[nodiscard]] std::expected<usize, Error> array_index(Utf8String const& token, usize const max_index) {
+            auto digits = std::string{};
+            for (auto const c : token) {
+                auto const character = c.as_string_view().front();
+                if (c.as_string_view().size() != 1 or character < '0' or character > '9') {
+                    return patch_error("invalid array index in JSON pointer");
+                }
+                digits.push_back(character);
+            }
+            if (digits.empty() or (digits.size() > 1 and digits.front() == '0')) {
+                return patch_error("invalid array index in JSON pointer");
+            }
+            auto index = usize{};
+            auto const conversion_result = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+            if (conversion_result.ec != std::errc{} or index > max_index) {
+                return patch_error("array index out of range");
+            }
+            return index;
+        }
+
+        [[nodiscard]] auto find_member(Object& object, Utf8String const& key) {
+            return std::ranges::find_if(object.values, [&](auto const& member) { return member.first.value == key; });
+        }
+
+        [[nodiscard]] auto find_member(Object const& object, Utf8String const& key) {
+            return std::ranges::find_if(object.values, [&](auto const& member) { return member.first.value == key; });
+        }
+
+        // Drops the source texts of `value` and all of its children. This is needed for every newly created value,
+        // since it may have been allocated at the address of a value that has been destroyed.
+        void forget_sources(Sources const sources, Value const& value) {
+            if (sources == nullptr) {
+                return;
+            }
+            sources->erase(&value);
+            if (auto const object = value.as_object()) {
+                for (auto const& member_value : object->values | std::views::values) {
+                    forget_sources(sources, *member_value);
+                }
+            } else if (auto const array = value.as_array()) {
+                for (auto const& element : array->elements) {
+                    forget_sources(sources, *element);
+                }
+            }
+        }
+
+        // Containers that are part of a shared subtree are copied before they get modified. The source text of
+        // the container is dropped since its contents are about to change.
+        void make_mutable(ValuePointer& slot, Sources const sources) {
+            if (slot->is_shared()) {
+                json::make_mutable(slot);
+                forget_sources(sources, *slot);
+            } else if (sources != nullptr) {
+                sources->erase(slot.get());
+            }
+        }
+
+        // Follows `tokens` to the value they refer to. All containers on the way are prepared for being modified,
+        // i.e. they are made mutable and their source text is dropped.
+        [[nodiscard]] std::expected<ValuePointer*, Error> resolve_for_modification(
+            ValuePointer& document,
+            Tokens const tokens,
+            Sources const sources
+        ) {
+            auto slot = &document;
+            for (auto const& token : tokens) {
+                make_mutable(*slot, sources);
+                if (auto const object = (*slot)->as_object()) {
+                    auto const member = find_member(*object, token);
+                    if (member == object->values.end()) {
+                        return patch_error("path does not exist");
+                    }
+                    slot = &member->second;
+                } else if (auto const array = (*slot)->as_array()) {
+                    if (array->elements.empty()) {
+                        return patch_error("path does not exist");
+                    }
+                    auto const index = array_index(token, array->elements.size() - 1);
+                    if (not index.has_value()) {
+                        return std::unexpected{ index.error() };
+                    }
+                    slot = &array->elements.at(index.value());
+                } else {
+                    return patch_error("path does not exist");
+                }
+            }
+            return slot;
+        }
+
+        [[nodiscard]] std::expected<Value const*, Error> resolve(Value const& document, Tokens const tokens) {
+            auto value = &document;
+            for (auto const& token : tokens) {
+                if (auto const object = value->as_object()) {
+                    auto const member = find_member(*object, token);
+                    if (member == object->values.cend()) {
+                        return patch_error("path does not exist");
+                    }
+                    value = member->second.get();
+                } else if (auto const array = value->as_array()) {
+                    if (array->elements.empty()) {
+                        return patch_error("path does not exist");
+                    }
+                    auto const index = array_index(token, array->elements.size() - 1);
+                    if (not index.has_value()) {
+                        return std::unexpected{ index.error() };
+                    }
+                    value = array->elements.at(index.value()).get();
+                } else {
+                    return patch_error("path does not exist");
+                }
+            }
+            return value;
+        }
+
+        // returns the container the last token refers into
+        [[nodiscard]] std::expected<Value*, Error> parent_for_modification(
+            ValuePointer& document,
+            Tokens const tokens,
+            Sources const sources
+        ) {
+            auto const parent = resolve_for_modification(document, tokens.first(tokens.size() - 1), sources);
+            if (not parent.has_value()) {
+                return std::unexpected{ parent.error() };
+            }
+            auto& slot = *parent.value();
+            make_mutable(slot, sources);
+            return slot.get();
+        }
+
+        [[nodiscard]] std::expected<void, Error> add(
+            ValuePointer& document,
+            Tokens const tokens,
+            ValuePointer value,
+            Sources const sources
+        ) {
+            if (tokens.empty()) {
+                document = std::move(value);
+                return {};
+            }
+            auto const parent = parent_for_modification(document, tokens, sources);
+            if (not parent.has_value()) {
+                return std::unexpected{ parent.error() };
+            }
+            auto const& token = tokens.back();
+            if (auto const object = parent.value()->as_object()) {
+                if (auto const member = find_member(*object, token); member != object->values.end()) {
+                    member->second = std::move(value);
+                } else {
+                    object->values.emplace_back(String{ token }, std::move(value));
+                }
+                return {};
+            }
+            if (auto const array = parent.value()->as_array()) {
+                if (token == Utf8String{ "-" }) {
+                    array->elements.push_back(std::move(value));
+                    return {};
+                }
+                auto const index = array_index(token, array->elements.size());
+                if (not index.has_value()) {
+                    return std::unexpected{ index.error() };
+                }
+                array->elements.insert(
+                    array->elements.begin() + static_cast<std::ptrdiff_t>(index.value()),
+                    std::move(value)
+                );
+                return {};
+            }
+            return patch_error("path does not exist");
+        }
+
+        [[nodiscard]] std::expected<ValuePointer, Error> remove(
+            ValuePointer& document,
+            Tokens const tokens,
+            Sources const sources
+        ) {
+            if (tokens.empty()) {
+                return patch_error("the document itself cannot be removed");
+            }
+            auto const parent = parent_for_modification(document, tokens, sources);
+            if (not parent.has_value()) {
+                return std::unexpected{ parent.error() };
+            }
+            auto const& token = tokens.back();
+            if (auto const object = parent.value()->as_object()) {
+                auto const member = find_member(*object, token);
+                if (member == object->values.end()) {
+                    return patch_error("path does not exist");
+                }
+                auto removed = std::move(member->second);
+                object->values.erase(member);
+                return removed;
+            }
+            if (auto const array = parent.value()->as_array(); array.has_value() and not array->elements.empty()) {
+                auto const index = array_index(token, array->elements.size() - 1);
+                if (not index.has_value()) {
+                    return std::unexpected{ index.error() };
+                }
+                auto const position = array->elements.begin() + static_cast<std::ptrdiff_t>(index.value());
+                auto removed = std::move(*position);
+                array->elements.erase(position);
+                return removed;
+            }
+            return patch_error("path does not exist");
+        }
+
+        [[nodiscard]] std::expected<void, Error> replace(
+            ValuePointer& document,
+            Tokens const tokens,
+            ValuePointer value,
+            Sources const sources
+        ) {
+            auto const target = resolve_for_modification(document, tokens, sources);
+            if (not target.has_value()) {
+                return std::unexpected{ target.error() };
+            }
+            *target.value() = std::move(value);
+            return {};
+        }
+
+        [[nodiscard]] tl::optional<Value const&> member_of(Object const& object, char const* const name) {
+            auto const member = find_member(object, Utf8String{ name });
+            if (member == object.values.cend()) {
+                return tl::nullopt;
+            }
+            return *member->second;
+        }
+
+        [[nodiscard]] std::expected<std::vector<Utf8String>, Error> pointer_member(
+            Object const& operation,
+            char const* const name
+        ) {
+            auto const member = member_of(operation, name);
+            if (not member.has_value() or not member->as_string().has_value()) {
+                return patch_error(std::format("operation is missing the string member '{}'", name));
+            }
+            return parse_pointer(member->as_string()->value);
+        }
+
+        [[nodiscard]] std::expected<void, Error> apply_operation(
+            ValuePointer& document,
+            Value const& operation,
+            Sources const sources
+        ) {
+            using namespace c2k::Utf8Literals;
+
+            auto const operation_object = operation.as_object();
+            if (not operation_object.has_value()) {
+                return patch_error("a patch operation must be an object");
+            }
+            auto const op_member = member_of(*operation_object, "op");
+            if (not op_member.has_value() or not op_member->as_string().has_value()) {
+                return patch_error("operation is missing the string member 'op'");
+            }
+            auto const& op = op_member->as_string()->value;
+            auto const clone = [&](Value const& value) {
+                auto result = value.clone();
+                forget_sources(sources, *result);
+                return result;
+            };
+            auto const path = pointer_member(*operation_object, "path");
+            if (not path.has_value()) {
+                return std::unexpected{ path.error() };
+            }
+
+            if (op == "remove"_utf8) {
+                if (auto const result = remove(document, path.value(), sources); not result.has_value()) {
+                    return std::unexpected{ result.error() };
+                }
+                return {};
+            }
+
+            if (op == "move"_utf8 or op == "copy"_utf8) {
+                auto const from = pointer_member(*operation_object, "from");
+                if (not from.has_value()) {
+                    return std::unexpected{ from.error() };
+                }
+                if (op == "copy"_utf8) {
+                    auto const source = resolve(*document, from.value());
+                    if (not source.has_value()) {
+                        return std::unexpected{ source.error() };
+                    }
+                    return add(document, path.value(), clone(*source.value()), sources);
+                }
+                if (from.value() == path.value()) {
+                    return {};
+                }
+                auto const is_prefix_of_path =
+                    from->size() < path->size()
+                    and std::ranges::equal(from.value(), Tokens{ path.value() }.first(from->size()));
+                if (is_prefix_of_path) {
+                    return patch_error("a value cannot be moved into one of its children");
+                }
+                auto removed = remove(document, from.value(), sources);
+                if (not removed.has_value()) {
+                    return std::unexpected{ removed.error() };
+                }
+                return add(document, path.value(), std::move(removed).value(), sources);
+            }
+
+            auto const value = member_of(*operation_object, "value");
+            if (not value.has_value()) {
+                return patch_error("operation is missing the member 'value'");
+            }
+            if (op == "add"_utf8) {
+                return add(document, path.value(), clone(*value), sources);
+            }
+            if (op == "replace"_utf8) {
+                return replace(document, path.value(), clone(*value), sources);
+            }
+            if (op == "test"_utf8) {
+                auto const target = resolve(*document, path.value());
+                if (not target.has_value()) {
+                    return std::unexpected{ target.error() };
+                }
+                if (not equals(*target.value(), *value, CompareOptions{ .ignore_member_order = true })) {
+                    return patch_error("test operation failed");
+                }
+                return {};
+            }
+            return patch_error("unknown patch operation");
+        }
+
+        void merge(ValuePointer& target, Value const& patch, Sources const sources) {
+            auto const patch_object = patch.as_object();
+            if (not patch_object.has_value()) {
+                target = patch.clone();
+                forget_sources(sources, *target);
+                return;
+            }
+            make_mutable(target, sources);
+            if (not target->as_object().has_value()) {
+                target = std::make_unique<Object>();
+                forget_sources(sources, *target);
+            }
+            auto& target_object = target->as_object().value();
+            for (auto const& [key, value] : patch_object->values) {
+                auto member = find_member(target_object, key.value);
+                if (value->is_null()) {
+                    if (member != target_object.values.end()) {
+                        target_object.values.erase(member);
+                    }
+                    continue;
+                }
+                if (member == target_object.values.end()) {
+                    target_object.values.emplace_back(String{ key.value }, std::make_unique<Null>());
+                    member = std::prev(target_object.values.end());
+                    forget_sources(sources, *member->second);
+                }
+                merge(member->second, *value, sources);
+            }
+        }
+
+        void reserialize(
+            Value const& value,
+            std::unordered_map<Value const*, Utf8StringView> const& sources,
+            usize const indentation_step,
+            usize const base_indentation,
+            Utf8String& result
+        ) {
+            using namespace c2k::Utf8Literals;
+
+            static constexpr auto insert_indent = [](Utf8String& string, usize const amount) {
+                for (auto i = usize{ 0 }; i < amount; ++i) {
+                    string += ' '_utf8;
+                }
+            };
+
+            if (auto const source = sources.find(&value); source != sources.cend()) {
+                for (auto const c : source->second) {
+                    result += c;
+                }
+                return;
+            }
+            if (auto const object = value.as_object(); object.has_value() and not object->values.empty()) {
+                result += "{\n"_utf8;
+                for (auto i = usize{ 0 }; i < object->values.size(); ++i) {
+                    auto const& [key, member_value] = object->values.at(i);
+                    insert_indent(result, base_indentation + indentation_step);
+                    result += key.format(0, 0);
+                    result += ": "_utf8;
+                    reserialize(*member_value, sources, indentation_step, base_indentation + indentation_step, result);
+                    result += i < object->values.size() - 1 ? ",\n"_utf8 : "\n"_utf8;
+                }
+                insert_indent(result, base_indentation);
+                result += "}"_utf8;
+                return;
+            }
+            if (auto const array = value.as_array(); array.has_value() and not array->elements.empty()) {
+                result += "[\n"_utf8;
+                for (auto i = usize{ 0 }; i < array->elements.size(); ++i) {
+                    insert_indent(result, base_indentation + indentation_step);
+                    reserialize(
+                        *array->elements.at(i),
+                        sources,
+                        indentation_step,
+                        base_indentation + indentation_step,
+                        result
+                    );
+                    result += i < array->elements.size() - 1 ? ",\n"_utf8 : "\n"_utf8;
+                }
+                insert_indent(result, base_indentation);
+                result += "]"_utf8;
+                return;
+            }
+            result += value.format(indentation_step, base_indentation);
+        }
+
+        [[nodiscard]] std::expected<void, Error> apply_operations(
+            ValuePointer& document,
+            Value const& patch,
+            Sources const sources
+        ) {
+            auto const operations = patch.as_array();
+            if (not operations.has_value()) {
+                return patch_error("a patch must be an array of operations");
+            }
+            for (auto const& operation : operations->elements) {
+                if (auto const result = apply_operation(document, *operation, sources); not result.has_value()) {
+                    return result;
+                }
+            }
+            return {};
+        }
+    }  // namespace
+
+    [[nodiscard]] std::expected<void, Error> apply_patch(ValuePointer& document, Value const& patch) {
+        return apply_operations(document, patch, nullptr);
+    }
+
+    [[nodiscard]] std::expected<void, Error> apply_patch(RetainedDocument& document, Value const& patch) {
+        return apply_operations(document.root, patch, &document.sources);
+    }
+
+    void apply_merge_patch(ValuePointer& document, Value const& patch) {
+        merge(document, patch, nullptr);
+    }
+
+    void apply_merge_patch(RetainedDocument& document, Value const& patch) {
+        merge(document.root, patch, &document.sources);
+    }
+
+    [[nodiscard]] Utf8String reserialize(RetainedDocument const& document, usize const indentation_step) {
+        auto result = Utf8String{};
+        reserialize(*document.root, document.sources, indentation_step, 0, result);
+        return result;
+    }
+}  // namespace c2k::json
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/boolean.hpp>
+#include <simple_json_parser/detail/comparison.hpp>
+#include <simple_json_parser/detail/number.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/schema.hpp>
+#include <utility>
+
+namespace c2k::json {
+    namespace detail {
+        namespace {
+            using namespace c2k::Utf8Literals;
+
+            [[nodiscard]] std::unexpected<Error> schema_error(std::string message) {
+                return std::unexpected<Error>{ SchemaError{ std::move(message) } };
+            }
+
+            [[nodiscard]] std::unexpected<Error> validation_error(std::string message) {
+                return std::unexpected<Error>{ ValidationError{ std::move(message) } };
+            }
+
+            [[nodiscard]] bool is_integer(double const value) {
+                return std::trunc(value) == value;
+            }
+
+            [[nodiscard]] u8 flag(SchemaType const type) {
+                return std::to_underlying(type);
+            }
+
+            [[nodiscard]] std::expected<u8, Error> type_flags(Utf8String const& name) {
+                if (name == "null"_utf8) {
+                    return flag(SchemaType::Null);
+                }
+                if (name == "boolean"_utf8) {
+                    return flag(SchemaType::Boolean);
+                }
+                if (name == "integer"_utf8) {
+                    return flag(SchemaType::Integer);
+                }
+                if (name == "number"_utf8) {
+                    return static_cast<u8>(flag(SchemaType::Integer) | flag(SchemaType::Fraction));
+                }
+                if (name == "string"_utf8) {
+                    return flag(SchemaType::String);
+                }
+                if (name == "array"_utf8) {
+                    return flag(SchemaType::Array);
+                }
+                if (name == "object"_utf8) {
+                    return flag(SchemaType::Object);
+                }
+                return schema_error(std::format("unknown type: {}", name.c_str()));
+            }
+
+            [[nodiscard]] std::expected<u8, Error> compile_type(Value const& type) {
+                if (auto const string = type.as_string()) {
+                    return type_flags(string->value);
+                }
+                auto const array = type.as_array();
+                if (not array) {
+                    return schema_error("'type' must be a string or an array of strings");
+                }
+                auto result = u8{ 0 };
+                for (auto const& element : array->elements) {
+                    auto const string = element->as_string();
+                    if (not string) {
+                        return schema_error("'type' must be a string or an array of strings");
+                    }
+                    auto const flags = type_flags(string->value);
+                    if (not flags.has_value()) {
+                        return std::unexpected{ flags.error() };
+                    }
+                    result = static_cast<u8>(result | flags.value());
+                }
+                return result;
+            }
+
+            [[nodiscard]] std::expected<double, Error> compile_number(Value const& value, Utf8String const& keyword) {
+                if (auto const number = value.as_number()) {
+                    return number->value;
+                }
+                return schema_error(std::format("'{}' must be a number", keyword.c_str()));
+            }
+
+            [[nodiscard]] std::expected<usize, Error> compile_count(Value const& value, Utf8String const& keyword) {
+                auto const number = value.as_number();
+                if (number and number->value >= 0.0 and is_integer(number->value)) {
+                    return static_cast<usize>(number->value);
+                }
+                return schema_error(std::format("'{}' must be a non-negative integer", keyword.c_str()));
+            }
+
+            // keywords that don't restrict the value
+            [[nodiscard]] bool is_annotation(Utf8String const& keyword) {
+                return keyword == "title"_utf8 or keyword == "description"_utf8 or keyword == "$schema"_utf8
+                       or keyword == "$id"_utf8 or keyword == "$comment"_utf8 or keyword == "default"_utf8
+                       or keyword == "examples"_utf8;
+            }
+
+            [[nodiscard]] std::expected<std::unique_ptr<SchemaNode>, Error> compile_node(Value const& schema) {
+                auto node = std::make_unique<SchemaNode>();
+                if (auto const boolean = schema.as_boolean()) {
+                    if (not boolean->value) {
+                        node->types = 0;
+                    }
+                    return node;
+                }
+                auto const object = schema.as_object();
+                if (not object) {
+                    return schema_error("schema must be an object or a boolean");
+                }
+
+                for (auto const& [key, value] : object->values) {
+                    auto const& keyword = key.value;
+                    if (keyword == "type"_utf8) {
+                        auto const types = compile_type(*value);
+                        if (not types.has_value()) {
+                            return std::unexpected{ types.error() };
+                        }
+                        node->types = types.value();
+                    } else if (keyword == "enum"_utf8) {
+                        auto const array = value->as_array();
+                        if (not array) {
+                            return schema_error("'enum' must be an array");
+                        }
+                        auto allowed_values = std::vector<ValuePointer>{};
+                        allowed_values.reserve(array->elements.size());
+                        for (auto const& element : array->elements) {
+                            allowed_values.push_back(element->clone());
+                        }
+                        node->allowed_values = std::move(allowed_values);
+                    } else if (keyword == "const"_utf8) {
+                        auto allowed_values = std::vector<ValuePointer>{};
+                        allowed_values.push_back(value->clone());
+                        node->allowed_values = std::move(allowed_values);
+                    } else if (keyword == "minimum"_utf8 or keyword == "maximum"_utf8
+                               or keyword == "exclusiveMinimum"_utf8 or keyword == "exclusiveMaximum"_utf8) {
+                        auto const number = compile_number(*value, keyword);
+                        if (not number.has_value()) {
+                            return std::unexpected{ number.error() };
+                        }
+                        auto& target = keyword == "minimum"_utf8            ? node->minimum
+                                       : keyword == "maximum"_utf8          ? node->maximum
+                                       : keyword == "exclusiveMinimum"_utf8 ? node->exclusive_minimum
+                                                                            : node->exclusive_maximum;
+                        target = number.value();
+                    } else if (keyword == "minLength"_utf8 or keyword == "maxLength"_utf8 or keyword == "minItems"_utf8
+                               or keyword == "maxItems"_utf8) {
+                        auto const count = compile_count(*value, keyword);
+                        if (not count.has_value()) {
+                            return std::unexpected{ count.error() };
+                        }
+                        auto& target = keyword == "minLength"_utf8   ? node->min_length
+                                       : keyword == "maxLength"_utf8 ? node->max_length
+                                       : keyword == "minItems"_utf8  ? node->min_items
+                                                                     : node->max_items;
+                        target = count.value();
+                    } else if (keyword == "properties"_utf8) {
+                        auto const properties = value->as_object();
+                        if (not properties) {
+                            return schema_error("'properties' must be an object");
+                        }
+                        for (auto const& [name, property_schema] : properties->values) {
+                            auto property = compile_node(*property_schema);
+                            if (not property.has_value()) {
+                                return std::unexpected{ property.error() };
+                            }
+                            node->properties.emplace_back(name.value, std::move(property).value());
+                        }
+                    } else if (keyword == "required"_utf8) {
+                        auto const array = value->as_array();
+                        if (not array) {
+                            return schema_error("'required' must be an array of strings");
+                        }
+                        for (auto const& element : array->elements) {
+                            auto const name = element->as_string();
+                            if (not name) {
+                                return schema_error("'required' must be an array of strings");
+                            }
+                            node->required.push_back(name->value);
+                        }
+                    } else if (keyword == "additionalProperties"_utf8 or keyword == "items"_utf8) {
+                        if (keyword == "items"_utf8 and value->is_array()) {
+                            return schema_error("'items' must be a single schema, tuple validation is not supported");
+                        }
+                        auto subschema = compile_node(*value);
+                        if (not subschema.has_value()) {
+                            return std::unexpected{ subschema.error() };
+                        }
+                        auto& target = keyword == "items"_utf8 ? node->items : node->additional_properties;
+                        target = std::move(subschema).value();
+                    } else if (not is_annotation(keyword)) {
+                        // ignoring a constraint would accept documents that the schema rejects
+                        return schema_error(std::format("unsupported keyword: {}", keyword.c_str()));
+                    }
+                }
+                return node;
+            }
+        }  // namespace
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_start(char const first_character) const {
+            auto const flags = [&] {
+                switch (first_character) {
+                    case 'n':
+                        return flag(SchemaType::Null);
+                    case 't':
+                    case 'f':
+                        return flag(SchemaType::Boolean);
+                    case '"':
+                        return flag(SchemaType::String);
+                    case '[':
+                        return flag(SchemaType::Array);
+                    case '{':
+                        return flag(SchemaType::Object);
+                    default:
+                        if (first_character == '-' or (first_character >= '0' and first_character <= '9')) {
+                            return static_cast<u8>(flag(SchemaType::Integer) | flag(SchemaType::Fraction));
+                        }
+                        // invalid input is rejected by the parser
+                        return all_types;
+                }
+            }();
+            if ((types & flags) == 0) {
+                return validation_error("value has a type that is not allowed by the schema");
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<SchemaNode const*, Error> SchemaNode::property(Utf8String const& key) const {
+            for (auto const& [name, schema] : properties) {
+                if (name == key) {
+                    return schema.get();
+                }
+            }
+            if (additional_properties != nullptr and additional_properties->types == 0) {
+                return validation_error(std::format("property is not allowed by the schema: {}", key.c_str()));
+            }
+            return additional_properties.get();
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_num_items(usize const num_items) const {
+            if (min_items.has_value() and num_items < min_items.value()) {
+                return validation_error(std::format("array has less than {} elements", min_items.value()));
+            }
+            if (max_items.has_value() and num_items > max_items.value()) {
+                return validation_error(std::format("array has more than {} elements", max_items.value()));
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_value(Value const& value) const {
+            auto result = std::expected<std::monostate, Error>{};
+            if (auto const number = value.as_number()) {
+                result = check_number(number->value);
+            } else if (auto const string = value.as_string()) {
+                result = check_string(string->value);
+            } else if (auto const array = value.as_array()) {
+                result = check_num_items(array->elements.size());
+            } else if (auto const object = value.as_object()) {
+                result = check_required(object->values);
+            }
+            if (not result.has_value()) {
+                return result;
+            }
+            if (allowed_values.has_value()) {
+                auto const is_allowed = std::ranges::any_of(allowed_values.value(), [&](ValuePointer const& allowed) {
+                    return equals(*allowed, value, CompareOptions{ .ignore_member_order = true });
+                });
+                if (not is_allowed) {
+                    return validation_error("value is not one of the values allowed by the schema");
+                }
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_number(double const value) const {
+            if ((types & flag(SchemaType::Fraction)) == 0 and not is_integer(value)) {
+                return validation_error("number is not an integer");
+            }
+            if (minimum.has_value() and value < minimum.value()) {
+                return validation_error(std::format("number is less than {}", minimum.value()));
+            }
+            if (maximum.has_value() and value > maximum.value()) {
+                return validation_error(std::format("number is greater than {}", maximum.value()));
+            }
+            if (exclusive_minimum.has_value() and value <= exclusive_minimum.value()) {
+                return validation_error(std::format("number is not greater than {}", exclusive_minimum.value()));
+            }
+            if (exclusive_maximum.has_value() and value >= exclusive_maximum.value()) {
+                return validation_error(std::format("number is not less than {}", exclusive_maximum.value()));
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_string(Utf8String const& value) const {
+            if (not min_length.has_value() and not max_length.has_value()) {
+                return std::monostate{};
+            }
+            // the length is measured in codepoints
+            auto length = usize{ 0 };
+            for ([[maybe_unused]] auto const c : value) {
+                ++length;
+            }
+            if (min_length.has_value() and length < min_length.value()) {
+                return validation_error(std::format("string is shorter than {} characters", min_length.value()));
+            }
+            if (max_length.has_value() and length > max_length.value()) {
+                return validation_error(std::format("string is longer than {} characters", max_length.value()));
+            }
+            return std::monostate{};
+        }
+
+        [[nodiscard]] std::expected<std::monostate, Error> SchemaNode::check_required(
+            std::span<std::pair<String, ValuePointer> const> const members
+        ) const {
+            for (auto const& name : required) {
+                auto const is_present = std::ranges::any_of(members, [&](auto const& member) {
+                    return member.first.value == name;
+                });
+                if (not is_present) {
+                    return validation_error(std::format("required property is missing: {}", name.c_str()));
+                }
+            }
+            return std::monostate{};
+        }
+    }  // namespace detail
+
+    [[nodiscard]] std::expected<Schema, Error> Schema::compile(Value const& schema) {
+        auto root = detail::compile_node(schema);
+        if (not root.has_value()) {
+            return std::unexpected{ root.error() };
+        }
+        return Schema{ std::move(root).value() };
+    }
+}  // namespace c2k::json
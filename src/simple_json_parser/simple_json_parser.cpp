@@ -7,7 +7,44 @@ namespace c2k::json {
         Utf8StringView const input,
         tl::optional<std::filesystem::path const&>
     ) {
-        auto parser = detail::Parser{ input };
+        auto state = detail::ParserState{};
+        auto parser = detail::Parser{ input, state };
         return parser.parse();
     }
+
+    [[nodiscard]] std::expected<ValuePointer, Error> parse(Utf8StringView const input, ParseOptions const& options) {
+        auto state = detail::ParserState{};
+        auto parser = detail::Parser{ input, state, options };
+        return parser.parse();
+    }
+
+    [[nodiscard]] std::expected<ValuePointer, Error> parse(Utf8StringView const input, Schema const& schema) {
+        auto state = detail::ParserState{};
+        auto parser = detail::Parser{ input, state };
+        return parser.parse(schema.root());
+    }
+
+    [[nodiscard]] std::expected<RetainedDocument, Error> parse_retaining_source(Utf8StringView const input) {
+        auto state = detail::ParserState{};
+        auto document = RetainedDocument{};
+        auto parser = detail::Parser{ input, detail::TreeSink{ state, &document.sources } };
+        auto root = parser.parse();
+        if (not root.has_value()) {
+            return std::unexpected{ root.error() };
+        }
+        document.root = std::move(root).value();
+        return document;
+    }
+
+    [[nodiscard]] std::expected<void, Error> validate(Utf8StringView const input, ValidateOptions const& options) {
+        auto validator = detail::Validator{
+            input,
+            detail::NullSink{ options.reject_duplicate_keys },
+            ParseOptions{ .max_depth = options.max_depth },
+        };
+        if (auto const result = validator.parse(); not result.has_value()) {
+            return std::unexpected{ result.error() };
+        }
+        return {};
+    }
 }  // namespace c2k::json
@@ -0,0 +1,287 @@
+#include <simple_json_parser/detail/array.hpp>
+#include <simple_json_parser/detail/boolean.hpp>
+#include <simple_json_parser/detail/null.hpp>
+#include <simple_json_parser/detail/number.hpp>
+#include <simple_json_parser/detail/object.hpp>
+#include <simple_json_parser/detail/string.hpp>
+#include <simple_json_parser/detail/tape.hpp>
+#include <simple_json_parser/detail/utf8.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace c2k::json {
+    namespace {
+        using detail::TapeType;
+
+        // "C2KJTAPE" when stored as little-endian
+        constexpr auto magic = u64{ 0x4550'4154'4A4B'3243 };
+        constexpr auto version = u64{ 1 };
+        // magic, version, number of tape words, number of string bytes
+        constexpr auto num_header_words = usize{ 4 };
+        constexpr auto max_payload = (u64{ 1 } << 56) - 1;
+        // protects `verify()` (which is recursive) against deeply nested tapes
+        constexpr auto max_verification_depth = usize{ 1024 };
+
+        [[nodiscard]] constexpr u64 tape_word(TapeType const type, u64 const payload = 0) {
+            return (static_cast<u64>(std::to_underlying(type)) << 56) | payload;
+        }
+
+        class TapeWriter final {
+            std::vector<u64> m_words;
+            std::string m_strings;
+            // keys tend to repeat (e.g. in arrays of records), so they are only stored once
+            std::unordered_map<std::string, u64> m_key_offsets;
+
+        public:
+            [[nodiscard]] std::vector<std::byte> write(Value const& value) && {
+                write_value(value);
+                auto result = std::vector<std::byte>{};
+                result.reserve((num_header_words + m_words.size()) * sizeof(u64) + m_strings.size());
+                append_word(result, magic);
+                append_word(result, version);
+                append_word(result, m_words.size());
+                append_word(result, m_strings.size());
+                for (auto const word : m_words) {
+                    append_word(result, word);
+                }
+                for (auto const c : m_strings) {
+                    result.push_back(static_cast<std::byte>(c));
+                }
+                return result;
+            }
+
+        private:
+            static void append_word(std::vector<std::byte>& output, u64 const word) {
+                for (auto i = usize{ 0 }; i < sizeof(u64); ++i) {
+                    output.push_back(std::byte{ static_cast<u8>(word >> (i * 8)) });
+                }
+            }
+
+            void write_value(Value const& value) {
+                if (auto const object = value.as_object()) {
+                    auto const start = begin_container(TapeType::Object, object->values.size());
+                    for (auto const& [key, member_value] : object->values) {
+                        write_string(key.value, true);
+                        write_value(*member_value);
+                    }
+                    end_container(start, TapeType::Object);
+                } else if (auto const array = value.as_array()) {
+                    auto const start = begin_container(TapeType::Array, array->elements.size());
+                    for (auto const& element : array->elements) {
+                        write_value(*element);
+                    }
+                    end_container(start, TapeType::Array);
+                } else if (auto const string = value.as_string()) {
+                    write_string(string->value, false);
+                } else if (auto const number = value.as_number()) {
+                    m_words.push_back(tape_word(TapeType::Number));
+                    m_words.push_back(std::bit_cast<u64>(number->value));
+                } else if (auto const boolean = value.as_boolean()) {
+                    m_words.push_back(tape_word(boolean->value ? TapeType::True : TapeType::False));
+                } else {
+                    m_words.push_back(tape_word(TapeType::Null));
+                }
+            }
+
+            [[nodiscard]] usize begin_container(TapeType const type, usize const size) {
+                auto const start = m_words.size();
+                m_words.push_back(tape_word(type));  // the end index is filled in later
+                m_words.push_back(size);
+                return start;
+            }
+
+            void end_container(usize const start, TapeType const type) {
+                m_words.at(start) = tape_word(type, m_words.size());
+            }
+
+            void write_string(Utf8String const& string, bool const is_key) {
+                auto bytes = std::string{};
+                for (auto const c : string) {
+                    bytes += c.as_string_view();
+                }
+                auto offset = u64{ m_strings.size() };
+                if (is_key) {
+                    auto const [iterator, inserted] = m_key_offsets.try_emplace(bytes, offset);
+                    offset = iterator->second;
+                    if (inserted) {
+                        m_strings += bytes;
+                    }
+                } else {
+                    m_strings += bytes;
+                }
+                m_words.push_back(tape_word(TapeType::String, offset));
+                m_words.push_back(bytes.size());
+            }
+        };
+
+        [[nodiscard]] std::unexpected<Error> tape_error(std::string message) {
+            return std::unexpected<Error>{ DecodeError{ std::move(message) } };
+        }
+
+        class TapeVerifier final {
+            detail::TapeView m_tape;
+
+        public:
+            explicit TapeVerifier(detail::TapeView const tape)
+                : m_tape{ tape } {}
+
+            [[nodiscard]] std::expected<void, Error> verify() const {
+                if (m_tape.num_words == 0) {
+                    return tape_error("empty tape");
+                }
+                auto const end = value(0, 0);
+                if (not end.has_value()) {
+                    return std::unexpected{ end.error() };
+                }
+                if (end.value() != m_tape.num_words) {
+                    return tape_error("unexpected data after the end of the root value");
+                }
+                return {};
+            }
+
+        private:
+            // returns the index after the value at `index`, which has to be in bounds
+            [[nodiscard]] std::expected<usize, Error> value(usize const index, usize const depth) const {
+                switch (m_tape.type(index)) {
+                    case TapeType::Null:
+                    case TapeType::True:
+                    case TapeType::False:
+                        return index + 1;
+                    case TapeType::Number:
+                        if (index + 2 > m_tape.num_words) {
+                            return tape_error("unexpected end of tape");
+                        }
+                        return index + 2;
+                    case TapeType::String:
+                        if (auto const result = string(index); not result.has_value()) {
+                            return std::unexpected{ result.error() };
+                        }
+                        return index + 2;
+                    case TapeType::Array:
+                    case TapeType::Object:
+                        return container(index, depth);
+                }
+                return tape_error("invalid value type");
+            }
+
+            [[nodiscard]] std::expected<void, Error> string(usize const index) const {
+                if (index + 2 > m_tape.num_words or m_tape.type(index) != TapeType::String) {
+                    return tape_error("expected string");
+                }
+                auto const offset = m_tape.payload(index);
+                auto const length = m_tape.word(index + 1);
+                if (offset > m_tape.num_string_bytes or length > m_tape.num_string_bytes - offset) {
+                    return tape_error("string out of bounds");
+                }
+                if (not detail::is_valid_utf8(m_tape.string(index))) {
+                    return tape_error("string is not valid UTF-8");
+                }
+                return {};
+            }
+
+            [[nodiscard]] std::expected<usize, Error> container(usize const index, usize const depth) const {
+                if (depth == max_verification_depth) {
+                    return tape_error("maximum nesting depth exceeded");
+                }
+                if (index + 2 > m_tape.num_words) {
+                    return tape_error("unexpected end of tape");
+                }
+                auto const is_object = m_tape.type(index) == TapeType::Object;
+                auto const end = m_tape.payload(index);
+                if (end > m_tape.num_words) {
+                    return tape_error("container out of bounds");
+                }
+                auto const size = m_tape.word(index + 1);
+                auto current = index + 2;
+                for (auto i = u64{ 0 }; i < size; ++i) {
+                    if (current >= end) {
+                        return tape_error("container size mismatch");
+                    }
+                    if (is_object) {
+                        if (auto const result = string(current); not result.has_value()) {
+                            return std::unexpected{ result.error() };
+                        }
+                        current += 2;
+                        if (current >= end) {
+                            return tape_error("container size mismatch");
+                        }
+                    }
+                    auto const next = value(current, depth + 1);
+                    if (not next.has_value()) {
+                        return std::unexpected{ next.error() };
+                    }
+                    current = next.value();
+                }
+                if (current != end) {
+                    return tape_error("container size mismatch");
+                }
+                return static_cast<usize>(end);
+            }
+        };
+    }  // namespace
+
+    [[nodiscard]] ValuePointer TapeValue::to_value() const {
+        if (auto const object = as_object()) {
+            auto values = Object::Members{};
+            values.reserve(object->values.size());
+            for (auto const& [key, value] : object->values) {
+                values.emplace_back(String{ Utf8String{ std::string{ key.value } } }, value.to_value());
+            }
+            return std::make_unique<Object>(std::move(values));
+        }
+        if (auto const array = as_array()) {
+            auto elements = Array::Elements{};
+            elements.reserve(array->elements.size());
+            for (auto const element : array->elements) {
+                elements.push_back(element.to_value());
+            }
+            return std::make_unique<Array>(std::move(elements));
+        }
+        if (auto const string = as_string()) {
+            return std::make_unique<String>(Utf8String{ std::string{ string->value } });
+        }
+        if (auto const number = as_number()) {
+            return std::make_unique<Number>(number->value);
+        }
+        if (auto const boolean = as_boolean()) {
+            return std::make_unique<Boolean>(boolean->value);
+        }
+        return std::make_unique<Null>();
+    }
+
+    [[nodiscard]] std::expected<TapeDocument, Error> TapeDocument::open(std::span<std::byte const> const data) {
+        auto const header_size = num_header_words * sizeof(u64);
+        if (data.size() < header_size) {
+            return tape_error("tape is too small");
+        }
+        auto const header = detail::TapeView{ data.data(), num_header_words, nullptr, 0 };
+        if (header.word(0) != magic) {
+            return tape_error("not a tape");
+        }
+        if (header.word(1) != version) {
+            return tape_error("unsupported tape version");
+        }
+        auto const num_words = header.word(2);
+        auto const num_string_bytes = header.word(3);
+        auto const max_num_words = (data.size() - header_size) / sizeof(u64);
+        if (num_words > max_num_words or num_words > max_payload
+            or num_string_bytes != data.size() - header_size - num_words * sizeof(u64)) {
+            return tape_error("tape size mismatch");
+        }
+        auto const words = data.data() + header_size;
+        return TapeDocument{ detail::TapeView{
+            words,
+            static_cast<usize>(num_words),
+            reinterpret_cast<char const*>(words + num_words * sizeof(u64)),
+            static_cast<usize>(num_string_bytes),
+        } };
+    }
+
+    [[nodiscard]] std::expected<void, Error> TapeDocument::verify() const {
+        return TapeVerifier{ m_tape }.verify();
+    }
+
+    [[nodiscard]] std::vector<std::byte> to_tape(Value const& value) {
+        return TapeWriter{}.write(value);
+    }
+}  // namespace c2k::json
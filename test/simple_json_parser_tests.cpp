@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <simple_json_parser/simple_json_parser.hpp>
+
+using namespace c2k::json;
+using namespace c2k::Utf8Literals;
+
+namespace {
+    // returns `tl::nullopt` if parsing `input` doesn't fail with a `ParseError`
+    [[nodiscard]] tl::optional<ParseError> parse_error(Utf8String const& input, ParseOptions const& options) {
+        auto const result = parse(input.view(), options);
+        if (result.has_value() or not std::holds_alternative<ParseError>(result.error())) {
+            return tl::nullopt;
+        }
+        return std::get<ParseError>(result.error());
+    }
+
+    // returns `text` repeated `count` times between `prefix` and `suffix`
+    [[nodiscard]] Utf8String
+    repeat(char const* const prefix, char const* const text, usize const count, char const* const suffix) {
+        auto result = Utf8String{ prefix };
+        for (auto i = usize{ 0 }; i < count; ++i) {
+            result += text;
+        }
+        result += suffix;
+        return result;
+    }
+
+    [[nodiscard]] std::vector<std::byte> bytes(std::initializer_list<int> const values) {
+        auto result = std::vector<std::byte>{};
+        for (auto const value : values) {
+            result.push_back(static_cast<std::byte>(value));
+        }
+        return result;
+    }
+
+    // returns `tl::nullopt` if decoding `data` doesn't fail with a `DecodeError`
+    [[nodiscard]] tl::optional<DecodeError> decode_error(std::vector<std::byte> const& data) {
+        auto const result = from_cbor(data);
+        if (result.has_value() or not std::holds_alternative<DecodeError>(result.error())) {
+            return tl::nullopt;
+        }
+        return std::get<DecodeError>(result.error());
+    }
+
+    // `depth` nested arrays containing a single zero
+    [[nodiscard]] std::vector<std::byte> nested_cbor_arrays(usize const depth) {
+        auto result = std::vector<std::byte>(depth, std::byte{ 0x81 });
+        result.push_back(std::byte{ 0x00 });
+        return result;
+    }
+}  // namespace
+
+TEST(ParseOptionsTests, MaxDepth) {
+    EXPECT_TRUE(parse("[[1]]"_utf8.view(), ParseOptions{ .max_depth = 2 }).has_value());
+    auto const error = parse_error("[[[1]]]"_utf8, { .max_depth = 2 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::MaximumDepthExceeded);
+    EXPECT_EQ(error->offset, 3);
+}
+
+TEST(ParseOptionsTests, MaxNodes) {
+    EXPECT_TRUE(parse("[1, 2]"_utf8.view(), ParseOptions{ .max_nodes = 3 }).has_value());
+    auto const error = parse_error("[1, 2, 3]"_utf8, { .max_nodes = 3 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::TooManyNodes);
+    EXPECT_EQ(error->offset, 6);
+}
+
+TEST(ParseOptionsTests, MaxStringLength) {
+    EXPECT_TRUE(parse(R"(["abcd"])"_utf8.view(), ParseOptions{ .max_string_length = 4 }).has_value());
+    auto const error = parse_error(R"(["abcdef"])"_utf8, { .max_string_length = 4 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::StringTooLong);
+    EXPECT_EQ(error->offset, 6);
+}
+
+TEST(ParseOptionsTests, MaxObjectMembers) {
+    EXPECT_TRUE(parse(R"({"a": 1, "b": 2})"_utf8.view(), ParseOptions{ .max_object_members = 2 }).has_value());
+    auto const error = parse_error(R"({"a": 1, "b": 2, "c": 3})"_utf8, { .max_object_members = 2 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::TooManyMembers);
+    EXPECT_EQ(error->offset, 16);
+}
+
+TEST(ParseOptionsTests, MaxNumberLength) {
+    EXPECT_TRUE(parse("[123]"_utf8.view(), ParseOptions{ .max_number_length = 3 }).has_value());
+    auto const error = parse_error("[123456]"_utf8, { .max_number_length = 3 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::NumberTooLong);
+    EXPECT_EQ(error->offset, 7);
+}
+
+TEST(ParseOptionsTests, MaxMemoryRejectsLongStringWhileReadingIt) {
+    auto const input = repeat("\"", "a", 1000, "\"");
+    auto const error = parse_error(input, { .max_memory = 16 });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::MemoryLimitExceeded);
+    // the 17th character is the first one that doesn't fit
+    EXPECT_EQ(error->offset, 17);
+}
+
+TEST(ParseOptionsTests, MaxMemoryRejectsLargeArrayWhileReadingIt) {
+    auto const input = repeat("[", "0,", 1000, "0]");
+    // enough for 10 elements and the number of the 11th element, but not for storing the 11th element in the array
+    auto const max_memory = 10 * (sizeof(Number) + sizeof(ValuePointer)) + sizeof(Number);
+    auto const error = parse_error(input, { .max_memory = max_memory });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::MemoryLimitExceeded);
+    // directly behind the 11th element
+    EXPECT_EQ(error->offset, 22);
+}
+
+TEST(ParseOptionsTests, MaxMemoryRejectsLargeObjectWhileReadingIt) {
+    auto const input = repeat("{", R"("a":0,)", 1000, R"("a":0})");
+    // every member consists of a key of one byte, a number, and the slot of the member in the object
+    auto const member_size = 1 + sizeof(Number) + sizeof(Object::Members::value_type);
+    auto const max_memory = 10 * member_size + 1 + sizeof(Number);
+    auto const error = parse_error(input, { .max_memory = max_memory });
+    ASSERT_TRUE(error.has_value());
+    EXPECT_EQ(error->code, ParseErrorCode::MemoryLimitExceeded);
+    // directly behind the 11th member
+    EXPECT_EQ(error->offset, 66);
+}
+
+TEST(CborTests, RoundTrip) {
+    auto const input = R"({
+        "integers": [0, 23, 24, 255, 256, 65536, 4294967296, -1, -25, -4294967297],
+        "floats": [0.5, -1.25, 0.1, 123456789.987654321, -0.0001],
+        "strings": ["", "hello", "\u00e4", "\u20ac", "\ud83e\udd80", "quote \" and backslash \\"],
+        "literals": [true, false, null],
+        "nested": {"empty array": [], "empty object": {}, "deep": [[[{"a": [1]}]]]}
+    })"_utf8;
+    auto const value = parse(input.view());
+    ASSERT_TRUE(value.has_value());
+    auto const decoded = from_cbor(to_cbor(**value));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(**decoded == **value);
+}
+
+TEST(CborTests, RoundTripOfLongContainers) {
+    auto const input = repeat("[", R"({"a": "text", "b": 1.5},)", 300, "null]");
+    auto const value = parse(input.view());
+    ASSERT_TRUE(value.has_value());
+    auto const decoded = from_cbor(to_cbor(**value));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(**decoded == **value);
+}
+
+TEST(CborTests, TruncatedLengths) {
+    // argument of the head is cut off
+    EXPECT_TRUE(decode_error(bytes({ 0x19, 0x01 })).has_value());
+    EXPECT_TRUE(decode_error(bytes({ 0x1B, 0x00, 0x00, 0x00 })).has_value());
+    // text string that is shorter than its length
+    EXPECT_TRUE(decode_error(bytes({ 0x65, 'a', 'b' })).has_value());
+    EXPECT_TRUE(decode_error(bytes({ 0x7B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 'a' })).has_value());
+    // containers with more elements than the input can hold, these must not reserve memory for all of them
+    EXPECT_TRUE(decode_error(bytes({ 0x82, 0x01 })).has_value());
+    EXPECT_TRUE(decode_error(bytes({ 0x9A, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 })).has_value());
+    auto const huge_map = bytes({ 0xBB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x61, 'a', 0x01 });
+    EXPECT_TRUE(decode_error(huge_map).has_value());
+    // indefinite length containers and strings without a break
+    EXPECT_TRUE(decode_error(bytes({ 0x9F, 0x01, 0x02 })).has_value());
+    EXPECT_TRUE(decode_error(bytes({ 0x7F, 0x61, 'a' })).has_value());
+    EXPECT_TRUE(decode_error(bytes({})).has_value());
+}
+
+TEST(CborTests, MaximumDepth) {
+    EXPECT_TRUE(from_cbor(nested_cbor_arrays(1024)).has_value());
+    auto const error = decode_error(nested_cbor_arrays(1025));
+    ASSERT_TRUE(error.has_value());
+    EXPECT_NE(error->description.find("depth"), std::string::npos);
+    // nesting way beyond the limit must not overflow the stack
+    EXPECT_TRUE(decode_error(nested_cbor_arrays(1'000'000)).has_value());
+}
+
+TEST(CborTests, DuplicateKeys) {
+    EXPECT_TRUE(from_cbor(bytes({ 0xA2, 0x61, 'a', 0x01, 0x61, 'b', 0x02 })).has_value());
+    auto const error = decode_error(bytes({ 0xA2, 0x61, 'a', 0x01, 0x61, 'a', 0x02 }));
+    ASSERT_TRUE(error.has_value());
+    EXPECT_NE(error->description.find("duplicate key"), std::string::npos);
+    // a key that is split into chunks is still the same key
+    auto const chunked_key = bytes({ 0xA2, 0x62, 'a', 'b', 0x01, 0x7F, 0x61, 'a', 0x61, 'b', 0xFF, 0x02 });
+    EXPECT_TRUE(decode_error(chunked_key).has_value());
+}
+
+TEST(CborTests, InvalidUtf8) {
+    EXPECT_TRUE(from_cbor(bytes({ 0x62, 0xC3, 0xA4 })).has_value());
+    // invalid continuation byte
+    EXPECT_TRUE(decode_error(bytes({ 0x62, 0xC3, 0x28 })).has_value());
+    // overlong encoding
+    EXPECT_TRUE(decode_error(bytes({ 0x62, 0xC0, 0x80 })).has_value());
+    // UTF-16 surrogate
+    EXPECT_TRUE(decode_error(bytes({ 0x63, 0xED, 0xA0, 0x80 })).has_value());
+    // code point beyond U+10FFFF
+    EXPECT_TRUE(decode_error(bytes({ 0x64, 0xF4, 0x90, 0x80, 0x80 })).has_value());
+    // sequence that is cut off by the end of the string
+    EXPECT_TRUE(decode_error(bytes({ 0x61, 0xC3, 0x00 })).has_value());
+    // invalid map key
+    EXPECT_TRUE(decode_error(bytes({ 0xA1, 0x61, 0xFF, 0x01 })).has_value());
+    // chunks of an indefinite length string are validated as a whole, a code point may span chunks
+    EXPECT_TRUE(from_cbor(bytes({ 0x7F, 0x61, 0xC3, 0x61, 0xA4, 0xFF })).has_value());
+    EXPECT_TRUE(decode_error(bytes({ 0x7F, 0x61, 0xC3, 0x61, 0x28, 0xFF })).has_value());
+}